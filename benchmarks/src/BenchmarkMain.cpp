@@ -9,9 +9,10 @@
 #include <iostream>
 #include <string>
 
-// Forward declaration from NodeBenchmarks.cpp
+// Forward declarations from NodeBenchmarks.cpp and SceneFormatBenchmarks.cpp
 namespace eSGraph::Benchmark {
 void registerNodeBenchmarks();
+void registerSceneFormatBenchmarks();
 }
 
 int main(int argc, char* argv[]) {
@@ -59,6 +60,7 @@ int main(int argc, char* argv[]) {
 
     // Register all benchmark scenarios
     registerNodeBenchmarks();
+    registerSceneFormatBenchmarks();
 
     // Run benchmarks and display results
     runner.runAll();
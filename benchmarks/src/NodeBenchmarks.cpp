@@ -8,7 +8,13 @@
 #include "BenchmarkFramework.hpp"
 #include "HierarchyBuilders.hpp"
 #include "Node.hpp"
+#include "Animation.hpp"
+#include "AimConstraints.hpp"
+#include "HierarchyIndex.hpp"
+#include <cmath>
 #include <memory>
+#include <string>
+#include <vector>
 
 using namespace eSGraph;
 using namespace eSGraph::Benchmark;
@@ -31,6 +37,26 @@ constexpr size_t DEEP_MEDIUM = 50;
 constexpr size_t DEEP_LARGE = 100;
 constexpr size_t TREE_SMALL = 10;   // ~1K nodes
 constexpr size_t TREE_MEDIUM = 15;  // ~32K nodes
+constexpr size_t TREE_SKELETON = 7; // 127 nodes
+
+Node* g_holders[2] = {nullptr, nullptr};
+std::vector<Node*> g_carriedNodes;
+size_t g_holderIndex = 0;
+
+std::unique_ptr<AnimationClip> g_clip;
+std::unique_ptr<AnimationBinding> g_binding;
+std::vector<Node*> g_animatedNodes;
+float g_time = 0.0f;
+
+std::unique_ptr<AimConstraints> g_aimConstraints;
+
+constexpr std::uint64_t LAYER_ENEMY = 1ull << 3;
+
+std::unique_ptr<HierarchyIndex> g_hierarchyIndex;
+std::vector<Node*> g_queryNodes;
+
+Node* g_handNode = nullptr;
+Node* g_weaponNode = nullptr;
 
 // ============================================================================
 // 1. Local Matrix Operations
@@ -163,6 +189,117 @@ void registerGlobalMatrixBenchmarks() {
             g_targetNode = nullptr;
         }
     );
+
+    // Spawns 1000 projectiles under one parent, then despawns them in spawn order
+    auto despawnAll = [](std::vector<Node*>& spawned) {
+        for (Node* node : spawned) {
+            DoNotOptimize(g_root->removeChild(node));
+        }
+        spawned.clear();
+    };
+
+    // BM_SpawnDespawn_Ordered_1000 - Baseline: addChild per node, ordered erase
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_SpawnDespawn_Ordered_1000",
+        [despawnAll]() {
+            std::vector<Node*> spawned;
+            spawned.reserve(FLAT_MEDIUM);
+            for (size_t i = 0; i < FLAT_MEDIUM; ++i) {
+                auto child = std::make_unique<Node>();
+                spawned.push_back(child.get());
+                g_root->addChild(std::move(child));
+            }
+            despawnAll(spawned);
+        },
+        []() {
+            g_root = std::make_unique<Node>("pool");
+        },
+        []() {
+            g_root.reset();
+        }
+    );
+
+    // BM_SpawnDespawn_Unordered_1000 - addChildren batch, swap-and-pop removal
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_SpawnDespawn_Unordered_1000",
+        [despawnAll]() {
+            std::vector<Node*> spawned;
+            std::vector<std::unique_ptr<Node>> batch;
+            spawned.reserve(FLAT_MEDIUM);
+            batch.reserve(FLAT_MEDIUM);
+            for (size_t i = 0; i < FLAT_MEDIUM; ++i) {
+                batch.push_back(std::make_unique<Node>());
+                spawned.push_back(batch.back().get());
+            }
+            g_root->addChildren(std::move(batch));
+            despawnAll(spawned);
+        },
+        []() {
+            g_root = std::make_unique<Node>("pool");
+            g_root->setUnorderedChildren(true);
+        },
+        []() {
+            g_root.reset();
+        }
+    );
+
+    // Moves 100 of 1000 children between two transformed holders, keeping world poses
+    auto setupHolders = []() {
+        g_root = std::make_unique<Node>("root");
+        for (Node*& holder : g_holders) {
+            auto node = std::make_unique<Node>("holder");
+            holder = node.get();
+            g_root->addChild(std::move(node));
+        }
+        g_holders[0]->setPosition(glm::vec3(3.0f, 1.0f, 0.0f));
+        g_holders[1]->setRotation(glm::angleAxis(0.5f, glm::vec3(0.0f, 1.0f, 0.0f)));
+        g_carriedNodes.clear();
+        for (size_t i = 0; i < FLAT_MEDIUM; ++i) {
+            auto child = std::make_unique<Node>("item_" + std::to_string(i));
+            child->setPosition(glm::vec3(static_cast<float>(i), 0.0f, 0.0f));
+            if (i % 10 == 0) {
+                g_carriedNodes.push_back(child.get());
+            }
+            g_holders[0]->addChild(std::move(child));
+        }
+        g_holderIndex = 0;
+    };
+    auto teardownHolders = []() {
+        g_carriedNodes.clear();
+        g_root.reset();
+    };
+
+    // BM_Reparent_DetachAttach_100 - Baseline: detach, addChild, WORLD setters per node
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_Reparent_DetachAttach_100",
+        []() {
+            g_holderIndex ^= 1;
+            Node* target = g_holders[g_holderIndex];
+            for (Node* node : g_carriedNodes) {
+                const glm::vec3 position = node->getPosition(Coordinates::WORLD);
+                const glm::quat rotation = node->getRotation(Coordinates::WORLD);
+                target->addChild(node->detach());
+                node->setPosition(position, Coordinates::WORLD);
+                node->setRotation(rotation, Coordinates::WORLD);
+            }
+            DoNotOptimize(target->getChildren().back()->getPosition());
+        },
+        setupHolders,
+        teardownHolders
+    );
+
+    // BM_Reparent_Batch_100 - Node::reparent with KeepWorld::YES
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_Reparent_Batch_100",
+        []() {
+            g_holderIndex ^= 1;
+            Node* target = g_holders[g_holderIndex];
+            Node::reparent(g_carriedNodes, target);
+            DoNotOptimize(target->getChildren().back()->getPosition());
+        },
+        setupHolders,
+        teardownHolders
+    );
 }
 
 // ============================================================================
@@ -579,6 +716,369 @@ void registerHierarchyModificationBenchmarks() {
     );
 }
 
+// ============================================================================
+// 8. Clone
+// ============================================================================
+
+void registerCloneBenchmarks() {
+    // BM_Clone_BinaryTree_10 (~1K nodes)
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_Clone_BinaryTree_10",
+        []() {
+            auto cloned = g_root->clone();
+            DoNotOptimize(cloned);
+        },
+        []() {
+            g_root = buildBinaryTree(TREE_SMALL);
+        },
+        []() {
+            g_root.reset();
+        }
+    );
+
+    // BM_Clone_DeepChain_100
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_Clone_DeepChain_100",
+        []() {
+            auto cloned = g_root->clone();
+            DoNotOptimize(cloned);
+        },
+        []() {
+            g_root = buildDeepHierarchy(DEEP_LARGE);
+        },
+        []() {
+            g_root.reset();
+        }
+    );
+}
+
+// ============================================================================
+// 9. Animation
+// ============================================================================
+
+void setupAnimatedTree() {
+    g_root = buildBinaryTree(TREE_SKELETON);
+    g_animatedNodes.clear();
+    g_root->traverse([](Node& node) { g_animatedNodes.push_back(&node); });
+
+    // 30 keys per track, varied enough that key reduction keeps them all
+    constexpr size_t keyCount = 30;
+    g_clip = std::make_unique<AnimationClip>(1.0f);
+    std::vector<float> times(keyCount);
+    std::vector<glm::vec3> positions(keyCount);
+    std::vector<glm::quat> rotations(keyCount);
+    for (size_t n = 0; n < g_animatedNodes.size(); ++n) {
+        for (size_t k = 0; k < keyCount; ++k) {
+            const float phase = static_cast<float>(k + n) * 0.7f;
+            times[k] = static_cast<float>(k) / static_cast<float>(keyCount - 1);
+            positions[k] = glm::vec3(std::sin(phase), std::cos(phase), 0.0f);
+            rotations[k] = glm::angleAxis(phase, glm::vec3(0.0f, 1.0f, 0.0f));
+        }
+        const std::string_view identifier = g_animatedNodes[n]->getIdentifier();
+        g_clip->addPositionTrack(identifier, times, positions);
+        g_clip->addRotationTrack(identifier, times, rotations);
+    }
+    g_binding = std::make_unique<AnimationBinding>(*g_clip, *g_root);
+    g_time = 0.0f;
+}
+
+void teardownAnimatedTree() {
+    g_binding.reset();
+    g_clip.reset();
+    g_animatedNodes.clear();
+    g_root.reset();
+}
+
+void registerAnimationBenchmarks() {
+    // BM_Animate_PerNodeSetters_127 - Baseline: individual setPosition/setRotation calls,
+    // without any keyframe sampling
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_Animate_PerNodeSetters_127",
+        []() {
+            g_time += 0.016f;
+            for (Node* node : g_animatedNodes) {
+                node->setPosition(glm::vec3(std::sin(g_time), std::cos(g_time), 0.0f));
+                node->setRotation(glm::angleAxis(g_time, glm::vec3(0.0f, 1.0f, 0.0f)));
+            }
+            DoNotOptimize(g_animatedNodes.back()->getGlobalMatrix());
+        },
+        setupAnimatedTree,
+        teardownAnimatedTree
+    );
+
+    // BM_Animate_ClipBinding_127 - Sample all tracks and write with one batched call
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_Animate_ClipBinding_127",
+        []() {
+            g_time += 0.016f;
+            if (g_time > 1.0f) {
+                g_time -= 1.0f;
+            }
+            g_binding->apply(g_time);
+            DoNotOptimize(g_animatedNodes.back()->getGlobalMatrix());
+        },
+        setupAnimatedTree,
+        teardownAnimatedTree
+    );
+}
+
+// ============================================================================
+// 10. Aim Constraints
+// ============================================================================
+
+void setupTurrets() {
+    g_root = buildFlatHierarchy(FLAT_MEDIUM);
+    g_root->setRotation(glm::angleAxis(0.3f, glm::vec3(0.0f, 1.0f, 0.0f)));
+    float offset = 0.0f;
+    for (const auto& child : g_root->getChildren()) {
+        child->setPosition(glm::vec3(offset, 0.0f, 0.0f));
+        offset += 1.0f;
+    }
+    g_aimConstraints = std::make_unique<AimConstraints>();
+    for (const auto& child : g_root->getChildren()) {
+        g_aimConstraints->add(child.get(), glm::vec3(0.0f, 5.0f, -50.0f));
+    }
+    g_time = 0.0f;
+}
+
+void teardownTurrets() {
+    g_aimConstraints.reset();
+    g_root.reset();
+}
+
+void registerAimConstraintBenchmarks() {
+    // BM_Aim_LookAt_Flat_1000 - Baseline: Node::lookAt per turret
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_Aim_LookAt_Flat_1000",
+        []() {
+            g_time += 0.1f;
+            const glm::vec3 target(std::sin(g_time) * 20.0f, 5.0f, -50.0f);
+            for (const auto& child : g_root->getChildren()) {
+                child->lookAt(target);
+            }
+            DoNotOptimize(g_root->getChildren().back()->getRotation());
+        },
+        setupTurrets,
+        teardownTurrets
+    );
+
+    // BM_Aim_Constraints_Flat_1000 - Registered constraints solved in one pass
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_Aim_Constraints_Flat_1000",
+        []() {
+            g_time += 0.1f;
+            const glm::vec3 target(std::sin(g_time) * 20.0f, 5.0f, -50.0f);
+            for (size_t i = 0; i < g_aimConstraints->size(); ++i) {
+                g_aimConstraints->setTargetPoint(i, target);
+            }
+            g_aimConstraints->solve();
+            DoNotOptimize(g_root->getChildren().back()->getRotation());
+        },
+        setupTurrets,
+        teardownTurrets
+    );
+}
+
+// ============================================================================
+// 11. Layer Masks
+// ============================================================================
+
+void setupTaggedTree() {
+    g_root = buildBinaryTree(TREE_MEDIUM);
+    // Tag roughly one node in 256, clustered the way gameplay objects usually are
+    size_t index = 0;
+    std::vector<Node*> tagged;
+    g_root->traverse([&](Node& node) {
+        if ((index++ / 64) % 256 == 0 && !node.hasChildren()) {
+            tagged.push_back(&node);
+        }
+    });
+    for (Node* node : tagged) {
+        node->setLayerMask(LAYER_ENEMY);
+    }
+}
+
+void registerLayerMaskBenchmarks() {
+    // BM_Layers_Predicate_Tree15 - Baseline: full traverse with a mask check
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_Layers_Predicate_Tree15",
+        []() {
+            size_t count = 0;
+            g_root->traverse([&](Node& node) {
+                if (node.getLayerMask() & LAYER_ENEMY) {
+                    ++count;
+                }
+            });
+            DoNotOptimize(count);
+        },
+        setupTaggedTree,
+        []() { g_root.reset(); }
+    );
+
+    // BM_Layers_Filtered_Tree15 - Subtree masks prune untagged branches
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_Layers_Filtered_Tree15",
+        []() {
+            size_t count = 0;
+            g_root->traverse(LAYER_ENEMY, [&](Node&) {
+                ++count;
+            });
+            DoNotOptimize(count);
+        },
+        setupTaggedTree,
+        []() { g_root.reset(); }
+    );
+}
+
+// ============================================================================
+// 12. Hierarchy Index
+// ============================================================================
+
+void setupAncestorQueries() {
+    g_root = buildBinaryTree(TREE_MEDIUM);
+    g_queryNodes.clear();
+    g_root->traverse([](Node& node) {
+        g_queryNodes.push_back(&node);
+    });
+    g_hierarchyIndex = std::make_unique<HierarchyIndex>(*g_root);
+    g_hierarchyIndex->rebuild();
+}
+
+void teardownAncestorQueries() {
+    g_hierarchyIndex.reset();
+    g_queryNodes.clear();
+    g_root.reset();
+}
+
+void registerHierarchyIndexBenchmarks() {
+    // Each iteration asks 1024 "is X under Y" questions against a subtree two levels down
+    constexpr size_t QUERIES = 1024;
+
+    // BM_Ancestor_PointerWalk_1024 - Baseline: walk mParent up to the root
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_Ancestor_PointerWalk_1024",
+        []() {
+            const Node* ancestor = g_root->getChildren()[1]->getChildren()[0].get();
+            const size_t stride = g_queryNodes.size() / QUERIES;
+            size_t hits = 0;
+            for (size_t i = 0; i < QUERIES; ++i) {
+                hits += g_queryNodes[i * stride]->isDescendantOf(ancestor) ? 1 : 0;
+            }
+            DoNotOptimize(hits);
+        },
+        setupAncestorQueries,
+        teardownAncestorQueries
+    );
+
+    // BM_Ancestor_Index_1024 - Interval test on Euler-tour stamps
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_Ancestor_Index_1024",
+        []() {
+            const Node* ancestor = g_root->getChildren()[1]->getChildren()[0].get();
+            const size_t stride = g_queryNodes.size() / QUERIES;
+            size_t hits = 0;
+            for (size_t i = 0; i < QUERIES; ++i) {
+                hits += g_hierarchyIndex->isAncestorOf(*ancestor, *g_queryNodes[i * stride]) ? 1 : 0;
+            }
+            DoNotOptimize(hits);
+        },
+        setupAncestorQueries,
+        teardownAncestorQueries
+    );
+
+    // BM_Depth_PointerWalk_1024 - Baseline: Node::getDepth
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_Depth_PointerWalk_1024",
+        []() {
+            const size_t stride = g_queryNodes.size() / QUERIES;
+            size_t total = 0;
+            for (size_t i = 0; i < QUERIES; ++i) {
+                total += g_queryNodes[i * stride]->getDepth();
+            }
+            DoNotOptimize(total);
+        },
+        setupAncestorQueries,
+        teardownAncestorQueries
+    );
+
+    // BM_Depth_Index_1024 - Stamped depth
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_Depth_Index_1024",
+        []() {
+            const size_t stride = g_queryNodes.size() / QUERIES;
+            size_t total = 0;
+            for (size_t i = 0; i < QUERIES; ++i) {
+                total += g_hierarchyIndex->getDepth(*g_queryNodes[i * stride]);
+            }
+            DoNotOptimize(total);
+        },
+        setupAncestorQueries,
+        teardownAncestorQueries
+    );
+
+    // BM_HierarchyIndex_Rebuild_Tree15 - Cost paid once after a structural change
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_HierarchyIndex_Rebuild_Tree15",
+        []() {
+            g_hierarchyIndex->rebuild();
+            DoNotOptimize(g_hierarchyIndex->size());
+        },
+        setupAncestorQueries,
+        teardownAncestorQueries
+    );
+}
+
+// ============================================================================
+// 13. Relative Transforms
+// ============================================================================
+
+void setupHandAndWeapon() {
+    g_root = buildDeepHierarchy(DEEP_MEDIUM);
+    Node* attach = getDeepestNode(g_root.get());
+    // hand and weapon three links each below a shared joint at the bottom of the chain
+    for (Node** leaf : {&g_handNode, &g_weaponNode}) {
+        Node* current = attach;
+        for (int i = 0; i < 3; ++i) {
+            auto child = std::make_unique<Node>("link");
+            child->setPosition(glm::vec3(0.1f, 0.2f, 0.0f));
+            child->setRotation(glm::angleAxis(0.1f, glm::vec3(0.0f, 0.0f, 1.0f)));
+            Node* childPtr = child.get();
+            current->addChild(std::move(child));
+            current = childPtr;
+        }
+        *leaf = current;
+    }
+    g_time = 0.0f;
+}
+
+void registerRelativeTransformBenchmarks() {
+    // BM_Relative_WorldInverse_Deep50 - Baseline: inverse(B world) * A world after the root moved
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_Relative_WorldInverse_Deep50",
+        []() {
+            g_time += 0.1f;
+            g_root->setPosition(glm::vec3(g_time, 0.0f, 0.0f));
+            const glm::mat4 relative = glm::inverse(g_handNode->getGlobalMatrix()) * g_weaponNode->getGlobalMatrix();
+            DoNotOptimize(relative);
+        },
+        setupHandAndWeapon,
+        []() { g_root.reset(); }
+    );
+
+    // BM_Relative_CommonAncestor_Deep50 - Composes the two short chains only
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_Relative_CommonAncestor_Deep50",
+        []() {
+            g_time += 0.1f;
+            g_root->setPosition(glm::vec3(g_time, 0.0f, 0.0f));
+            const glm::mat4 relative = g_weaponNode->getTransformRelativeTo(*g_handNode);
+            DoNotOptimize(relative);
+        },
+        setupHandAndWeapon,
+        []() { g_root.reset(); }
+    );
+}
+
 // ============================================================================
 // Registration function called from main
 // ============================================================================
@@ -591,6 +1091,12 @@ void registerAllBenchmarks() {
     registerRotationBenchmarks();
     registerDirectionVectorBenchmarks();
     registerHierarchyModificationBenchmarks();
+    registerCloneBenchmarks();
+    registerAnimationBenchmarks();
+    registerAimConstraintBenchmarks();
+    registerLayerMaskBenchmarks();
+    registerHierarchyIndexBenchmarks();
+    registerRelativeTransformBenchmarks();
 }
 
 } // anonymous namespace
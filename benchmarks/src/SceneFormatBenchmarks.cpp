@@ -0,0 +1,89 @@
+//
+//  SceneFormatBenchmarks.cpp
+//  eSGraph Benchmarks
+//
+//  Load-time benchmarks for the binary scene format
+//
+
+#include "BenchmarkFramework.hpp"
+#include "HierarchyBuilders.hpp"
+#include "Node.hpp"
+#include "SceneFormat.hpp"
+#include <memory>
+#include <vector>
+
+using namespace eSGraph;
+using namespace eSGraph::Benchmark;
+
+namespace {
+
+std::unique_ptr<Node> g_root;
+std::vector<std::byte> g_sceneBytes;
+
+constexpr size_t TREE_SMALL = 10;   // ~1K nodes
+constexpr size_t TREE_MEDIUM = 15;  // ~32K nodes
+
+void registerSceneLoadBenchmarks() {
+    // BM_SceneBuild_NodeApi_BinaryTree_10 - Baseline: node-by-node construction
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_SceneBuild_NodeApi_BinaryTree_10",
+        []() {
+            auto root = buildBinaryTree(TREE_SMALL);
+            DoNotOptimize(root);
+        }
+    );
+
+    // BM_SceneLoad_Instantiate_BinaryTree_10 - Bulk conversion into Node trees
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_SceneLoad_Instantiate_BinaryTree_10",
+        []() {
+            auto view = SceneView::open(g_sceneBytes);
+            auto root = view->instantiate();
+            DoNotOptimize(root);
+        },
+        []() {
+            g_sceneBytes = SceneWriter::write(*buildBinaryTree(TREE_SMALL));
+        },
+        []() {
+            g_sceneBytes.clear();
+        }
+    );
+
+    // BM_SceneLoad_OpenView_BinaryTree_15 - Zero-copy access, validation only
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_SceneLoad_OpenView_BinaryTree_15",
+        []() {
+            auto view = SceneView::open(g_sceneBytes);
+            DoNotOptimize(view);
+        },
+        []() {
+            g_sceneBytes = SceneWriter::write(*buildBinaryTree(TREE_MEDIUM));
+        },
+        []() {
+            g_sceneBytes.clear();
+        }
+    );
+
+    // BM_SceneWrite_BinaryTree_10
+    BenchmarkRunner::instance().registerBenchmark(
+        "BM_SceneWrite_BinaryTree_10",
+        []() {
+            auto bytes = SceneWriter::write(*g_root);
+            DoNotOptimize(bytes);
+        },
+        []() {
+            g_root = buildBinaryTree(TREE_SMALL);
+        },
+        []() {
+            g_root.reset();
+        }
+    );
+}
+
+} // anonymous namespace
+
+namespace eSGraph::Benchmark {
+void registerSceneFormatBenchmarks() {
+    registerSceneLoadBenchmarks();
+}
+} // namespace eSGraph::Benchmark
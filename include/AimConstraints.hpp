@@ -0,0 +1,72 @@
+//
+//  AimConstraints.hpp
+//  eSGraph
+//
+//  Batched aim (lookAt) constraints solved parent-first
+//
+
+#ifndef AimConstraints_h
+#define AimConstraints_h
+
+#define GLM_FORCE_XYZW_ONLY
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "glm/gtc/quaternion.hpp"
+
+namespace eSGraph {
+class Node;
+
+// Each constraint turns its source node so that -Z points at a target node or a fixed
+// point, blended by weight with the node's unconstrained rotation: the last local
+// rotation written by anything other than solve(), so repeated solves do not creep. Constraints are solved
+// in order of source depth so an aimed parent is final before its children read it.
+// Constrained and target nodes are referenced, not owned, and must outlive their
+// constraints; call invalidateOrder() after reparenting a constrained node.
+class AimConstraints
+{
+public:
+    size_t add(Node* source, Node* target,
+               const glm::vec3& up = glm::vec3(0.0f, 1.0f, 0.0f), float weight = 1.0f);
+    size_t add(Node* source, const glm::vec3& targetPoint,
+               const glm::vec3& up = glm::vec3(0.0f, 1.0f, 0.0f), float weight = 1.0f);
+    // Swap-and-pop: the last constraint takes over the removed index
+    void remove(size_t index);
+    void clear() noexcept;
+
+    [[nodiscard]] size_t size() const noexcept { return mConstraints.size(); }
+
+    void setTarget(size_t index, Node* target);
+    void setTargetPoint(size_t index, const glm::vec3& targetPoint);
+    void setWeight(size_t index, float weight);
+    [[nodiscard]] float getWeight(size_t index) const noexcept { return mConstraints[index].weight; }
+
+    void invalidateOrder() noexcept { mOrderDirty = true; }
+
+    // Aims every source in one pass
+    void solve();
+
+private:
+    struct Constraint
+    {
+        Node* source;
+        Node* target;
+        glm::vec3 targetPoint;
+        glm::vec3 up;
+        float weight;
+        // Unconstrained rotation to blend from, and what solve() last wrote over it
+        glm::quat base;
+        glm::quat written;
+    };
+
+    std::vector<Constraint> mConstraints;
+    std::vector<std::uint32_t> mOrder;
+    bool mOrderDirty{false};
+
+    void sortByDepth();
+};
+
+}
+
+#endif /* AimConstraints_h */
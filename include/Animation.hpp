@@ -0,0 +1,124 @@
+//
+//  Animation.hpp
+//  eSGraph
+//
+//  Keyframe clips sampled in batches and written straight into bound nodes
+//
+
+#ifndef Animation_h
+#define Animation_h
+
+#define GLM_FORCE_XYZW_ONLY
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "glm/gtc/quaternion.hpp"
+
+namespace eSGraph {
+class Node;
+
+enum class AnimationChannel : std::uint8_t
+{
+    POSITION,
+    ROTATION,
+    SCALE
+};
+
+// Tracks of one channel kind are stored back to back: key times, key values and
+// per-track ranges in flat arrays. Keys that linear interpolation reproduces within
+// the tolerance are dropped when a track is added, so constant tracks keep one key.
+class AnimationClip
+{
+public:
+    explicit AnimationClip(float duration, float tolerance = 1e-4f);
+
+    [[nodiscard]] float getDuration() const noexcept { return mDuration; }
+
+    // Times must be ascending and match values in size
+    void addPositionTrack(std::string_view identifier, std::span<const float> times, std::span<const glm::vec3> values);
+    void addRotationTrack(std::string_view identifier, std::span<const float> times, std::span<const glm::quat> values);
+    void addScaleTrack(std::string_view identifier, std::span<const float> times, std::span<const glm::vec3> values);
+
+    [[nodiscard]] size_t getTrackCount() const noexcept;
+    [[nodiscard]] size_t getKeyCount(AnimationChannel channel) const noexcept;
+
+private:
+    struct Track
+    {
+        std::uint32_t target;
+        std::uint32_t firstKey;
+        std::uint32_t keyCount;
+    };
+
+    template<typename T>
+    struct Channel
+    {
+        std::vector<Track> tracks;
+        std::vector<float> times;
+        std::vector<T> values;
+    };
+
+    float mDuration;
+    float mTolerance;
+    std::vector<std::string> mTargets;
+    Channel<glm::vec3> mPositions;
+    Channel<glm::quat> mRotations;
+    Channel<glm::vec3> mScales;
+
+    std::uint32_t internTarget(std::string_view identifier);
+    template<typename T>
+    void addTrack(Channel<T>& channel, std::string_view identifier, std::span<const float> times, std::span<const T> values);
+
+    friend class AnimationBinding;
+};
+
+// A clip resolved against one Node subtree. apply() samples every track and writes
+// all bound nodes with a single Node::setLocalTransforms call.
+class AnimationBinding
+{
+public:
+    AnimationBinding(const AnimationClip& clip, Node& root);
+
+    [[nodiscard]] size_t getBoundNodeCount() const noexcept { return mNodes.size(); }
+    [[nodiscard]] size_t getUnboundTrackCount() const noexcept { return mUnboundTracks; }
+
+    // Time is clamped to [0, duration]
+    void apply(float time);
+
+private:
+    // Per channel, the bound tracks and the pose slot each one writes
+    struct Target
+    {
+        std::uint32_t track;
+        std::uint32_t slot;
+    };
+
+    const AnimationClip& mClip;
+    std::vector<Node*> mNodes;
+    std::vector<Target> mPositionTargets;
+    std::vector<Target> mRotationTargets;
+    std::vector<Target> mScaleTargets;
+    size_t mUnboundTracks{0};
+
+    // Key cursors per bound track, so forward playback avoids the binary search
+    std::vector<std::uint32_t> mPositionCursors;
+    std::vector<std::uint32_t> mRotationCursors;
+    std::vector<std::uint32_t> mScaleCursors;
+
+    // Sampling scratch: segment start key and blend factor per bound track
+    std::vector<std::uint32_t> mKeys;
+    std::vector<float> mBlends;
+
+    // Pose written to the nodes, in subtree pre-order
+    std::vector<glm::vec3> mPositions;
+    std::vector<glm::quat> mRotations;
+    std::vector<glm::vec3> mScales;
+};
+
+}
+
+#endif /* Animation_h */
@@ -0,0 +1,93 @@
+//
+//  ConstraintStage.hpp
+//  eSGraph
+//
+//  Parent, position, orientation and two-bone IK constraints evaluated per frame
+//
+
+#ifndef ConstraintStage_h
+#define ConstraintStage_h
+
+#define GLM_FORCE_XYZW_ONLY
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "glm/gtc/quaternion.hpp"
+
+namespace eSGraph {
+class Node;
+
+enum class ConstraintType : std::uint8_t
+{
+    PARENT,
+    POSITION,
+    ORIENTATION,
+    TWO_BONE_IK
+};
+
+// Constraints write their result straight into the constrained nodes' cached world
+// transforms; local TRS stays the unconstrained input, so evaluating every frame does
+// not accumulate. Only the children of a constrained node are invalidated, and the
+// override lasts until the node itself is next invalidated.
+//
+// evaluate() runs constraints in dependency order: a constraint that reads a node
+// (its target, or an ancestor of what it writes) runs after any constraint writing
+// that node or one of its ancestors. Cycles fall back to registration order.
+// Nodes are referenced, not owned, and must outlive their constraints; call
+// invalidateOrder() after reparenting a constrained or target node.
+class ConstraintStage
+{
+public:
+    // Follow the target's world transform, keeping the current offset to it when
+    // maintainOffset is set
+    size_t addParentConstraint(Node* node, Node* target, float weight = 1.0f, bool maintainOffset = true);
+    // Take the target's world position; rotation and scale are kept
+    size_t addPositionConstraint(Node* node, Node* target, float weight = 1.0f);
+    // Take the target's world rotation; position and scale are kept
+    size_t addOrientationConstraint(Node* node, Node* target, float weight = 1.0f);
+    // Rotate upper and middle so that end reaches the target, keeping the current bend
+    // plane. middle must be a child of upper and end a child of middle.
+    size_t addTwoBoneIK(Node* upper, Node* middle, Node* end, Node* target, float weight = 1.0f);
+
+    // Swap-and-pop: the last constraint takes over the removed index
+    void remove(size_t index);
+    void clear() noexcept;
+
+    [[nodiscard]] size_t size() const noexcept { return mConstraints.size(); }
+    [[nodiscard]] ConstraintType getType(size_t index) const noexcept { return mConstraints[index].type; }
+    void setWeight(size_t index, float weight);
+    [[nodiscard]] float getWeight(size_t index) const noexcept { return mConstraints[index].weight; }
+
+    void invalidateOrder() noexcept { mOrderDirty = true; }
+
+    void evaluate();
+
+private:
+    struct Constraint
+    {
+        ConstraintType type;
+        float weight;
+        Node* node;
+        Node* target;
+        Node* middle;
+        Node* end;
+        glm::mat4 offset;
+    };
+
+    std::vector<Constraint> mConstraints;
+    std::vector<std::uint32_t> mOrder;
+    bool mOrderDirty{false};
+
+    size_t add(const Constraint& constraint);
+    void sortByDependencies();
+
+    static void evaluateParent(const Constraint& constraint);
+    static void evaluatePosition(const Constraint& constraint);
+    static void evaluateOrientation(const Constraint& constraint);
+    static void evaluateTwoBoneIK(const Constraint& constraint);
+};
+
+}
+
+#endif /* ConstraintStage_h */
@@ -0,0 +1,73 @@
+//
+//  DestructionQueue.hpp
+//  eSGraph
+//
+//  Deferred, iterative destruction of detached subtrees
+//
+
+#ifndef DestructionQueue_h
+#define DestructionQueue_h
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace eSGraph {
+class Node;
+
+enum class DestructionMode
+{
+    TIME_SLICED,  // update() destroys nodes on the calling thread under a budget
+    BACKGROUND    // a worker thread destroys subtrees as soon as they are pushed
+};
+
+// Takes ownership of detached subtrees and releases them one node at a time. In
+// BACKGROUND mode the subtrees must not be tracked by a TransformRecorder or
+// MotionHistory, whose bookkeeping belongs to the main thread. push() may be called
+// from any thread in either mode; TIME_SLICED update() and flush() hold the same lock
+// while they destroy. The destructor releases everything still queued.
+class DestructionQueue
+{
+public:
+    explicit DestructionQueue(DestructionMode mode = DestructionMode::TIME_SLICED);
+    ~DestructionQueue();
+
+    DestructionQueue(const DestructionQueue&) = delete;
+    DestructionQueue& operator=(const DestructionQueue&) = delete;
+
+    void push(std::unique_ptr<Node> subtree);
+
+    // TIME_SLICED: destroys nodes until the queue is empty or the budget is spent,
+    // at least one node per call. Returns the number of nodes destroyed.
+    size_t update(std::chrono::microseconds budget);
+    // Destroys everything queued now (BACKGROUND: waits for the worker to catch up)
+    void flush();
+
+    [[nodiscard]] DestructionMode getMode() const noexcept { return mMode; }
+    // Nodes known to be waiting: queued subtree roots plus children already unpacked
+    [[nodiscard]] size_t getPendingCount() const;
+
+private:
+    DestructionMode mMode;
+
+    mutable std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::condition_variable mDrained;
+    std::vector<std::unique_ptr<Node>> mPending;
+    bool mBusy{false};
+    bool mStopping{false};
+
+    std::thread mWorker;
+
+    void run();
+    // Releases the top of the stack after moving its children onto the stack
+    static void destroyOne(std::vector<std::unique_ptr<Node>>& pending);
+};
+
+}
+
+#endif /* DestructionQueue_h */
@@ -0,0 +1,62 @@
+//
+//  HierarchyIndex.hpp
+//  eSGraph
+//
+//  Euler-tour stamps for constant-time ancestor and depth queries
+//
+
+#ifndef HierarchyIndex_h
+#define HierarchyIndex_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eSGraph {
+class Node;
+
+// Numbers the hierarchy under a root in depth-first order: a node's descendants are
+// exactly the nodes whose enter stamp falls inside its [enter, exit] interval. The
+// stamps live on the nodes and are rebuilt on the next query after any structural
+// change. Changes are tracked by one global counter rather than per hierarchy, so
+// editing an unrelated tree also triggers a rebuild. The root must stay a root while
+// indexed, and queried nodes must belong to its hierarchy.
+class HierarchyIndex
+{
+public:
+    explicit HierarchyIndex(Node& root);
+
+    HierarchyIndex(const HierarchyIndex&) = delete;
+    HierarchyIndex& operator=(const HierarchyIndex&) = delete;
+
+    // Strict: a node is not its own ancestor
+    [[nodiscard]] bool isAncestorOf(const Node& ancestor, const Node& node);
+    [[nodiscard]] std::uint32_t getDepth(const Node& node);
+    [[nodiscard]] std::uint32_t getSubtreeSize(const Node& node);
+
+    [[nodiscard]] bool isStale() const noexcept;
+    void rebuild();
+
+    [[nodiscard]] Node& getRoot() const noexcept { return mRoot; }
+    [[nodiscard]] size_t size() const noexcept { return mSize; }
+
+private:
+    Node& mRoot;
+    std::uint32_t mBuiltVersion{0};
+    bool mBuilt{false};
+    size_t mSize{0};
+    std::vector<Node*> mStack;
+    std::vector<Node*> mOrder;
+
+    void refresh()
+    {
+        if (isStale())
+        {
+            rebuild();
+        }
+    }
+};
+
+}
+
+#endif /* HierarchyIndex_h */
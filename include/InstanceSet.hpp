@@ -0,0 +1,135 @@
+//
+//  InstanceSet.hpp
+//  eSGraph
+//
+//  Many lightweight placements of one immutable prototype subtree
+//
+
+#ifndef InstanceSet_h
+#define InstanceSet_h
+
+#define GLM_FORCE_XYZW_ONLY
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "glm/gtc/quaternion.hpp"
+
+namespace eSGraph {
+class Node;
+
+// Flattened, immutable copy of a Node subtree in depth-first pre-order.
+// Index 0 is the prototype root; every parent index is smaller than its child's.
+class Prototype
+{
+public:
+    static constexpr std::uint32_t NO_PARENT = std::numeric_limits<std::uint32_t>::max();
+    static constexpr size_t NOT_FOUND = std::numeric_limits<size_t>::max();
+
+    explicit Prototype(const Node& root);
+
+    [[nodiscard]] size_t size() const noexcept { return mParents.size(); }
+    [[nodiscard]] size_t find(std::string_view identifier) const noexcept;
+
+    [[nodiscard]] std::uint32_t getParentIndex(size_t index) const noexcept { return mParents[index]; }
+    [[nodiscard]] std::span<const std::uint32_t> getParentIndices() const noexcept { return mParents; }
+    [[nodiscard]] std::string_view getIdentifier(size_t index) const noexcept { return mIdentifiers[index]; }
+    [[nodiscard]] const glm::vec3& getPosition(size_t index) const noexcept { return mPositions[index]; }
+    [[nodiscard]] const glm::quat& getRotation(size_t index) const noexcept { return mRotations[index]; }
+    [[nodiscard]] const glm::vec3& getScale(size_t index) const noexcept { return mScales[index]; }
+
+    // Transforms relative to the prototype root. The root entry is identity because
+    // each placement supplies its own root transform.
+    [[nodiscard]] std::span<const glm::mat4> getModelMatrices() const noexcept { return mModelMatrices; }
+
+private:
+    std::vector<std::uint32_t> mParents;
+    std::vector<std::string> mIdentifiers;
+    std::vector<glm::vec3> mPositions;
+    std::vector<glm::quat> mRotations;
+    std::vector<glm::vec3> mScales;
+    std::vector<glm::mat4> mModelMatrices;
+};
+
+// Placements only store their root transform. Editing an internal node copies the
+// prototype's local transforms for that placement alone (copy-on-write), so memory
+// grows with the number of edited placements rather than the number of placements.
+class InstanceSet
+{
+public:
+    explicit InstanceSet(std::shared_ptr<const Prototype> prototype);
+
+    [[nodiscard]] const Prototype& getPrototype() const noexcept { return *mPrototype; }
+    [[nodiscard]] size_t size() const noexcept { return mPositions.size(); }
+    [[nodiscard]] size_t getEditedCount() const noexcept { return mEdits.size(); }
+
+    size_t spawn(const glm::vec3& position,
+                 const glm::quat& rotation = glm::identity<glm::quat>(),
+                 const glm::vec3& scale = glm::vec3(1.0f));
+    // Swap-and-pop: the last placement takes over the removed index
+    void despawn(size_t instance);
+    void clear();
+
+    // Root transform
+    void setPosition(size_t instance, const glm::vec3& position);
+    void setRotation(size_t instance, const glm::quat& rotation);
+    void setScale(size_t instance, const glm::vec3& scale);
+    [[nodiscard]] const glm::vec3& getPosition(size_t instance) const noexcept { return mPositions[instance]; }
+    [[nodiscard]] const glm::quat& getRotation(size_t instance) const noexcept { return mRotations[instance]; }
+    [[nodiscard]] const glm::vec3& getScale(size_t instance) const noexcept { return mScales[instance]; }
+    [[nodiscard]] glm::mat4 getRootMatrix(size_t instance) const;
+
+    // Internal node edits (node 0 is the root and is edited through the setters above)
+    void setLocalPosition(size_t instance, size_t node, const glm::vec3& position);
+    void setLocalRotation(size_t instance, size_t node, const glm::quat& rotation);
+    void setLocalScale(size_t instance, size_t node, const glm::vec3& scale);
+    [[nodiscard]] const glm::vec3& getLocalPosition(size_t instance, size_t node) const;
+    [[nodiscard]] const glm::quat& getLocalRotation(size_t instance, size_t node) const;
+    [[nodiscard]] const glm::vec3& getLocalScale(size_t instance, size_t node) const;
+    [[nodiscard]] bool isEdited(size_t instance) const noexcept { return mEditSlots[instance] != NO_EDIT; }
+    void revert(size_t instance);
+
+    // World transforms
+    [[nodiscard]] glm::mat4 getGlobalMatrix(size_t instance, size_t node);
+    // out receives getPrototype().size() matrices in prototype order
+    void computeGlobalMatrices(size_t instance, std::span<glm::mat4> out);
+    // out receives size() * getPrototype().size() matrices, instance-major
+    void computeAllGlobalMatrices(std::span<glm::mat4> out);
+
+    // Materialize a placement as a regular, independent Node tree
+    [[nodiscard]] std::unique_ptr<Node> instantiate(size_t instance) const;
+
+private:
+    static constexpr std::uint32_t NO_EDIT = std::numeric_limits<std::uint32_t>::max();
+
+    struct Edit
+    {
+        size_t instance;
+        bool modelMatricesDirty{true};
+        std::vector<glm::vec3> positions;
+        std::vector<glm::quat> rotations;
+        std::vector<glm::vec3> scales;
+        std::vector<glm::mat4> modelMatrices;
+    };
+
+    std::shared_ptr<const Prototype> mPrototype;
+
+    std::vector<glm::vec3> mPositions;
+    std::vector<glm::quat> mRotations;
+    std::vector<glm::vec3> mScales;
+    std::vector<std::uint32_t> mEditSlots;
+
+    std::vector<Edit> mEdits;
+
+    Edit& editFor(size_t instance);
+    [[nodiscard]] std::span<const glm::mat4> getModelMatrices(size_t instance);
+};
+
+}
+
+#endif /* InstanceSet_h */
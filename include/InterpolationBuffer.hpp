@@ -0,0 +1,68 @@
+//
+//  InterpolationBuffer.hpp
+//  eSGraph
+//
+//  Render-rate interpolation between the last two simulation snapshots
+//
+
+#ifndef InterpolationBuffer_h
+#define InterpolationBuffer_h
+
+#define GLM_FORCE_XYZW_ONLY
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "glm/gtc/quaternion.hpp"
+
+namespace eSGraph {
+class Node;
+
+// Keeps the local TRS of every node in a subtree for the previous and the current
+// simulation tick. interpolate() builds world matrices from the blended local
+// transforms without reading or writing any Node, so render frames between ticks
+// never touch the authoritative state or its cached matrices.
+//
+// The subtree layout is captured at construction; rebuild the buffer after adding or
+// removing nodes. The subtree is placed under its parent's world matrix from the
+// latest capture.
+class InterpolationBuffer
+{
+public:
+    static constexpr std::uint32_t NO_PARENT = 0xFFFFFFFF;
+
+    // Both snapshots start as the subtree's current state
+    explicit InterpolationBuffer(Node& root);
+
+    [[nodiscard]] size_t size() const noexcept { return mNodes.size(); }
+    [[nodiscard]] Node* getNode(size_t index) const noexcept { return mNodes[index]; }
+
+    // Call once per simulation tick, after the tick has updated the nodes
+    void capture();
+
+    // alpha = 0 gives the previous tick, 1 the current one. out receives size()
+    // world matrices in depth-first pre-order.
+    void interpolate(float alpha, std::span<glm::mat4> out) const;
+
+private:
+    struct Snapshot
+    {
+        std::vector<glm::vec3> positions;
+        std::vector<glm::quat> rotations;
+        std::vector<glm::vec3> scales;
+    };
+
+    std::vector<Node*> mNodes;
+    std::vector<std::uint32_t> mParents;
+    glm::mat4 mParentMatrix{1.0f};
+
+    Snapshot mPrevious;
+    Snapshot mCurrent;
+
+    void read(Snapshot& snapshot);
+};
+
+}
+
+#endif /* InterpolationBuffer_h */
@@ -0,0 +1,64 @@
+//
+//  LodSelector.hpp
+//  eSGraph
+//
+//  Batch distance-based level-of-detail selection relative to a camera node
+//
+
+#ifndef LodSelector_h
+#define LodSelector_h
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace eSGraph {
+class Node;
+
+class LodSelector
+{
+public:
+    // hysteresis is the fraction of each switch distance used as a dead band,
+    // so a node near a boundary does not flicker between two levels.
+    explicit LodSelector(float hysteresis = 0.1f);
+
+    // switchDistances must be ascending. LOD i is used while the node is closer
+    // than switchDistances[i]; beyond the last distance the coarsest LOD
+    // (switchDistances.size()) is selected.
+    size_t addNode(Node* node, std::span<const float> switchDistances);
+    void clear();
+
+    [[nodiscard]] size_t size() const noexcept { return mNodes.size(); }
+    [[nodiscard]] float getHysteresis() const noexcept { return mHysteresis; }
+
+    // Computes squared camera distances from cached world matrices and updates
+    // the LOD of every registered node. Results are indexed by registration order.
+    std::span<const std::uint8_t> select(Node& camera);
+
+    [[nodiscard]] std::span<const std::uint8_t> getLods() const noexcept { return mLods; }
+    [[nodiscard]] std::span<const float> getSquaredDistances() const noexcept { return mSquaredDistances; }
+
+private:
+    float mHysteresis;
+
+    std::vector<Node*> mNodes;
+
+    // Per-node ranges into the flat squared threshold arrays
+    std::vector<std::uint32_t> mThresholdOffsets;
+    std::vector<std::uint8_t> mThresholdCounts;
+    std::vector<float> mSquaredUpThresholds;
+    std::vector<float> mSquaredDownThresholds;
+
+    // Structure-of-arrays scratch for the distance pass
+    std::vector<float> mPositionsX;
+    std::vector<float> mPositionsY;
+    std::vector<float> mPositionsZ;
+
+    std::vector<float> mSquaredDistances;
+    std::vector<std::uint8_t> mLods;
+};
+
+}
+
+#endif /* LodSelector_h */
@@ -0,0 +1,72 @@
+//
+//  MotionHistory.hpp
+//  eSGraph
+//
+//  Previous-frame world matrices for motion vectors
+//
+
+#ifndef MotionHistory_h
+#define MotionHistory_h
+
+#define GLM_FORCE_XYZW_ONLY
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "glm/gtc/quaternion.hpp"
+
+namespace eSGraph {
+class Node;
+
+struct MotionMatrices
+{
+    glm::mat4 current;
+    glm::mat4 previous;
+};
+
+// Tracked nodes report the moment their world matrix is invalidated from the dirty
+// propagation walk, so advanceFrame() only touches nodes that moved this frame or
+// the frame before. Nodes that did not move keep previous equal to current, and
+// frozen subtrees are never visited.
+class MotionHistory
+{
+public:
+    MotionHistory() = default;
+    ~MotionHistory();
+
+    MotionHistory(const MotionHistory&) = delete;
+    MotionHistory& operator=(const MotionHistory&) = delete;
+
+    std::uint32_t track(Node* node);
+    // Tracks every node of the subtree in pre-order; returns the root's id
+    std::uint32_t trackSubtree(Node& root);
+    void untrack(Node* node);
+
+    [[nodiscard]] Node* getNode(std::uint32_t id) const noexcept;
+    [[nodiscard]] size_t getMovedCount() const noexcept { return mMoved.size(); }
+
+    // Call once per frame after the scene update: current becomes this frame's world
+    // matrix and previous the last frame's for every node that moved
+    void advanceFrame();
+
+    [[nodiscard]] const MotionMatrices& getMatrices(std::uint32_t id) const noexcept { return mMatrices[id]; }
+    // Gathers (current, previous) for the given ids, e.g. the visible set
+    void exportMatrices(std::span<const std::uint32_t> ids, std::span<MotionMatrices> out) const;
+
+private:
+    std::vector<Node*> mNodes;
+    std::vector<MotionMatrices> mMatrices;
+    std::vector<std::uint8_t> mMarked;
+    std::vector<std::uint32_t> mMoved;
+    // Moved in the last advanced frame: previous still differs from current
+    std::vector<std::uint32_t> mSettling;
+
+    friend class Node;
+    void markMoved(std::uint32_t id);
+    void forget(std::uint32_t id) noexcept;
+};
+
+}
+
+#endif /* MotionHistory_h */
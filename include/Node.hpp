@@ -10,14 +10,24 @@
 
 #define GLM_FORCE_XYZW_ONLY
 
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <vector>
 #include <memory>
 #include <functional>
+#include <span>
+#include <atomic>
 #include "glm/gtc/quaternion.hpp"
 
 namespace eSGraph {
+class TransformRecorder;
+class MotionHistory;
+class ConstraintStage;
+class HierarchyIndex;
+class DestructionQueue;
+class Node;
+
 enum class Coordinates
 {
     LOCAL,
@@ -25,6 +35,63 @@ enum class Coordinates
     WORLD
 };
 
+// Which parts of the parent's world transform a node follows
+enum class TransformInheritance : std::uint8_t
+{
+    NONE = 0,
+    TRANSLATION = 1 << 0,
+    ROTATION = 1 << 1,
+    SCALE = 1 << 2,
+    ALL = TRANSLATION | ROTATION | SCALE
+};
+
+constexpr TransformInheritance operator|(TransformInheritance a, TransformInheritance b) noexcept
+{
+    return static_cast<TransformInheritance>(static_cast<std::uint8_t>(a) | static_cast<std::uint8_t>(b));
+}
+
+constexpr TransformInheritance operator&(TransformInheritance a, TransformInheritance b) noexcept
+{
+    return static_cast<TransformInheritance>(static_cast<std::uint8_t>(a) & static_cast<std::uint8_t>(b));
+}
+
+// Generational reference to a node: resolves to nullptr once the node is destroyed,
+// even after its slot has been reused. toId() packs it into a 64-bit key that is
+// unique within the process; it is not persistent across runs or save/reload.
+struct NodeHandle
+{
+    std::uint32_t index{0};  // 0 is the null handle
+    std::uint32_t generation{0};
+
+    [[nodiscard]] bool isNull() const noexcept { return index == 0; }
+    [[nodiscard]] std::uint64_t toId() const noexcept
+    {
+        return (static_cast<std::uint64_t>(generation) << 32) | index;
+    }
+    [[nodiscard]] static NodeHandle fromId(std::uint64_t id) noexcept
+    {
+        return {static_cast<std::uint32_t>(id), static_cast<std::uint32_t>(id >> 32)};
+    }
+    friend bool operator==(const NodeHandle&, const NodeHandle&) = default;
+};
+
+enum class KeepWorld : bool
+{
+    NO = false,
+    YES = true
+};
+
+// Holds one relative transform between getTransformRelativeTo() calls; reused while
+// neither node's world matrix has been invalidated
+struct RelativeTransformCache
+{
+    glm::mat4 matrix{1.0f};
+    const Node* source{nullptr};
+    const Node* target{nullptr};
+    std::uint32_t sourceVersion{0};
+    std::uint32_t targetVersion{0};
+};
+
 struct DirectionVectors
 {
     glm::vec3 forward;
@@ -37,21 +104,49 @@ class Node
 public:
     Node();
     explicit Node(std::string identifier);
-    virtual ~Node() = default;
+    // Iterative: descendants are released from an explicit stack, so chain depth is
+    // not bounded by the call stack
+    virtual ~Node();
 
     [[nodiscard]] std::string_view getIdentifier() const noexcept { return mIdentifier; }
+
+    // Handles are allocated on first request, so nodes that are never referenced this
+    // way cost nothing; the slot is released when the node is destroyed. The slot
+    // table is shared and locked, so handles may be requested, resolved and released
+    // from any thread, but a single node's first getHandle() must not race itself.
+    [[nodiscard]] NodeHandle getHandle() const;
+    [[nodiscard]] std::uint64_t getId() const { return getHandle().toId(); }
+    [[nodiscard]] static Node* resolve(NodeHandle handle) noexcept;
+    // One lock for the whole batch; unresolvable handles yield nullptr
+    static void resolve(std::span<const NodeHandle> handles, std::span<Node*> nodes) noexcept;
     void setIdentifier(std::string_view identifier);
 
     void addChild(std::unique_ptr<Node> child);
+    // One reserve, one structure/layer update for the whole batch
+    void addChildren(std::vector<std::unique_ptr<Node>>&& children);
     [[nodiscard]] std::unique_ptr<Node> removeChild(Node* child);
     [[nodiscard]] std::unique_ptr<Node> removeChild(std::string_view identifier);
     [[nodiscard]] std::vector<std::unique_ptr<Node>> removeAllChildren();
+    void reserveChildren(size_t count) { mChildren.reserve(count); }
+    // Unordered children: removeChild() swaps the last child into the hole instead of
+    // shifting the tail, so sibling order is not preserved across removals
+    void setUnorderedChildren(bool unordered) noexcept { mUnorderedChildren = unordered; }
+    [[nodiscard]] bool hasUnorderedChildren() const noexcept { return mUnorderedChildren; }
 
     static void attachTo(std::unique_ptr<Node> node, Node* parent);
     [[nodiscard]] std::unique_ptr<Node> detach();
+    // Moves attached nodes under newParent in one pass: each old parent's children are
+    // compacted once, and with KeepWorld::YES the new local TRS is decomposed from
+    // affine inverses so the world pose is unchanged. newParent must not lie inside
+    // any of the moved subtrees; nodes listed more than once are moved once.
+    static void reparent(std::span<Node* const> nodes, Node* newParent, KeepWorld keepWorld = KeepWorld::YES);
 
     [[nodiscard]] bool isChildOf(const Node* parent) const noexcept;
     [[nodiscard]] bool isChildOf(std::string_view identifier) const noexcept;
+    // Nearest node that is an ancestor of (or equal to) both; nullptr across hierarchies
+    [[nodiscard]] Node* findCommonAncestor(Node& other) noexcept;
+    // Walks the parent chain; HierarchyIndex answers the same question in O(1)
+    [[nodiscard]] bool isDescendantOf(const Node* ancestor) const noexcept;
     [[nodiscard]] bool hasParent() const noexcept { return mParent != nullptr; }
     [[nodiscard]] bool hasChild(const Node* child) const noexcept;
     [[nodiscard]] bool hasChild(std::string_view childIdentifier) const;
@@ -74,6 +169,19 @@ public:
     template<typename Visitor>
     void traverse(Visitor&& visitor) const;
 
+    // Layer masks: the subtree mask ORs this node's mask with its children's subtree
+    // masks and is kept current by hierarchy and mask changes
+    void setLayerMask(std::uint64_t layers);
+    [[nodiscard]] std::uint64_t getLayerMask() const noexcept { return mLayerMask; }
+    [[nodiscard]] std::uint64_t getSubtreeLayerMask() const noexcept { return mSubtreeLayerMask; }
+
+    // Visits nodes sharing any bit with layers, skipping subtrees that contain none
+    template<typename Visitor>
+    void traverse(std::uint64_t layers, Visitor&& visitor);
+
+    template<typename Visitor>
+    void traverse(std::uint64_t layers, Visitor&& visitor) const;
+
     void setPosition(const glm::vec3& position, Coordinates coordinates = Coordinates::LOCAL);
     [[nodiscard]] glm::vec3 getPosition(Coordinates coordinates = Coordinates::LOCAL) const;
 
@@ -88,8 +196,23 @@ public:
     void setScale(float scaleFactor);
     [[nodiscard]] const glm::vec3& getScale() const noexcept { return mScale; }
 
+    // Batched local transform write: one dirty pass per node, no quaternion renormalization.
+    // Empty spans leave that component unchanged; non-empty spans must match nodes.size().
+    static void setLocalTransforms(std::span<Node* const> nodes,
+                                   std::span<const glm::vec3> positions,
+                                   std::span<const glm::quat> rotations,
+                                   std::span<const glm::vec3> scales);
+
     [[nodiscard]] const glm::mat4& getMatrix();
     [[nodiscard]] const glm::mat4& getGlobalMatrix();
+    // Incremented each time the cached global matrix is recomputed
+    [[nodiscard]] std::uint32_t getGlobalMatrixVersion() const noexcept { return mGlobalMatrixVersion; }
+
+    // Maps this node's space into target's space by composing local matrices up to the
+    // common ancestor only; falls back to world matrices across hierarchies or when
+    // either chain has partial inheritance or a constraint override
+    [[nodiscard]] glm::mat4 getTransformRelativeTo(Node& target);
+    [[nodiscard]] const glm::mat4& getTransformRelativeTo(Node& target, RelativeTransformCache& cache);
 
     void translate(const glm::vec3& translationVector, Coordinates coordinates = Coordinates::LOCAL);
 
@@ -111,8 +234,47 @@ public:
     // LookAt
     void lookAt(const glm::vec3& target, const glm::vec3& up = glm::vec3(0.0f, 1.0f, 0.0f));
 
-    // Clone
+    // Floating origin: each root carries a double-precision origin that world matrices
+    // and world getters/setters are expressed relative to. Rebasing bumps a global
+    // epoch instead of walking the scene; on their next read, nodes compare the origin
+    // their world matrix was cached against with their root's. Only hierarchies whose
+    // origin changed recompute, and frozen matrices are shifted rather than re-baked.
+    static void rebaseOrigin(std::span<Node* const> roots, const glm::dvec3& delta);
+    void setOrigin(const glm::dvec3& origin);
+    [[nodiscard]] const glm::dvec3& getOrigin() const noexcept { return mOrigin; }
+
+    // Absolute world translation accumulated in double, independent of the floating
+    // origin; computed on first use and cached until the node is invalidated. Frozen
+    // nodes return the position baked with their world matrix.
+    [[nodiscard]] const glm::dvec3& getPreciseWorldPosition();
+    // One pass over nodes: world basis from getGlobalMatrix() with the translation
+    // subtracted from cameraPosition in double, so only small offsets reach float
+    static void exportCameraRelativeMatrices(std::span<Node* const> nodes,
+                                             const glm::dvec3& cameraPosition,
+                                             std::span<glm::mat4> matrices);
+
+    // Inheritance flags are honored by world matrices, world rotations and the world
+    // getters and setters. Partial inheritance treats the parent world matrix as
+    // translation, rotation and per-axis scale.
+    void setInheritance(TransformInheritance inheritance);
+    [[nodiscard]] TransformInheritance getInheritance() const noexcept { return mInheritance; }
+    // Parent world transform as this node inherits it (the origin offset for roots)
+    [[nodiscard]] glm::mat4 getInheritedParentMatrix() const;
+    // getInheritedParentMatrix() * local, except that roots subtract their origin from
+    // the local translation in double, like getGlobalMatrix(), before narrowing
+    [[nodiscard]] glm::mat4 applyInheritedParentMatrix(const glm::mat4& local) const;
+    [[nodiscard]] glm::quat getInheritedParentRotation() const;
+
+    // Clone (iterative, subtree sized up front, no per-child dirty propagation)
     [[nodiscard]] std::unique_ptr<Node> clone() const;
+    [[nodiscard]] std::vector<std::unique_ptr<Node>> clone(size_t count) const;
+
+    // Static subtrees: world matrices are baked once and the subtree is excluded
+    // from dirty propagation until unfreeze(). Baked matrices are appended in
+    // depth-first pre-order when bakedMatrices is provided.
+    void freeze(std::vector<glm::mat4>* bakedMatrices = nullptr);
+    void unfreeze();
+    [[nodiscard]] bool isStatic() const noexcept { return mStatic; }
 
 protected:
     // Hot path - checked frequently
@@ -120,6 +282,10 @@ protected:
     bool mMatrixDirty{true};
     bool mGlobalMatrixDirty{true};
     mutable bool mWorldRotationDirty{true};
+    bool mStatic{false};
+    bool mGlobalOverride{false};
+    bool mPreciseDirty{true};
+    TransformInheritance mInheritance{TransformInheritance::ALL};
 
     // Transform data
     glm::vec3 mPosition{0.0f};
@@ -130,14 +296,69 @@ protected:
     glm::mat4 mMatrix{glm::identity<glm::mat4>()};
     glm::mat4 mGlobalMatrix{glm::identity<glm::mat4>()};
     mutable glm::quat mWorldRotation{glm::identity<glm::quat>()};
+    std::uint32_t mGlobalMatrixVersion{0};
+    std::uint32_t mOriginEpoch{0};
+    // Origin the cached world matrix is relative to, checked when mOriginEpoch lags
+    glm::dvec3 mCachedOrigin{0.0};
+    glm::dvec3 mPreciseWorldPosition{0.0};
 
     // Cold data
     std::string mIdentifier;
     std::vector<std::unique_ptr<Node>> mChildren;
+    std::uint64_t mLayerMask{0};
+    std::uint64_t mSubtreeLayerMask{0};
+    // Position in mParent->mChildren, kept current by every hierarchy change
+    std::uint32_t mChildIndex{0};
+    bool mUnorderedChildren{false};
+    mutable NodeHandle mHandle;
+    // Euler-tour stamps written by HierarchyIndex
+    std::uint32_t mTourEnter{0};
+    std::uint32_t mTourExit{0};
+    std::uint32_t mTourDepth{0};
+    TransformRecorder* mRecorder{nullptr};
+    std::uint32_t mRecorderIndex{0};
+    MotionHistory* mMotionHistory{nullptr};
+    std::uint32_t mMotionIndex{0};
+    glm::dvec3 mOrigin{0.0};  // Only meaningful on roots
+
+    // Bumped by every origin change; nodes whose mOriginEpoch lags re-check their origin
+    static std::atomic<std::uint32_t> sOriginEpoch;
+    // Bumped by every structural change anywhere; a single counter keeps addChild and
+    // removeChild from walking up to the root just to invalidate indices
+    static std::atomic<std::uint32_t> sStructureEpoch;
+
+    friend class TransformRecorder;
+    friend class MotionHistory;
+    friend class ConstraintStage;
+    friend class HierarchyIndex;
+    friend class DestructionQueue;
+    friend class SceneView;
 
     void setMatrixDirty();
+    void refreshSubtreeLayerMask();
+    static void bumpStructureEpoch() noexcept
+    {
+        sStructureEpoch.fetch_add(1, std::memory_order_relaxed);
+    }
     void setGlobalMatrixDirty();
     [[nodiscard]] const glm::quat& getWorldRotationCached() const;
+    void syncOrigin();
+    [[nodiscard]] bool isOriginCurrent() const noexcept
+    {
+        return mOriginEpoch == sOriginEpoch.load(std::memory_order_relaxed) ||
+               mCachedOrigin == getRoot()->mOrigin;
+    }
+    [[nodiscard]] bool inherits(TransformInheritance component) const noexcept
+    {
+        return (mInheritance & component) != TransformInheritance::NONE;
+    }
+    // Replaces the cached world transform until the node is next invalidated; the
+    // local TRS is left as is and children are invalidated to pick up the new parent
+    void overrideGlobalTransform(const glm::mat4& globalMatrix, const glm::quat& worldRotation);
+
+    void collectSubtree(std::vector<const Node*>& nodes, std::vector<std::uint32_t>& parents) const;
+    [[nodiscard]] static std::unique_ptr<Node> cloneCollected(const std::vector<const Node*>& nodes,
+                                                              const std::vector<std::uint32_t>& parents);
 };
 
 // Template implementations
@@ -161,6 +382,40 @@ void Node::traverse(Visitor&& visitor) const
     }
 }
 
+template<typename Visitor>
+void Node::traverse(std::uint64_t layers, Visitor&& visitor)
+{
+    if ((mSubtreeLayerMask & layers) == 0)
+    {
+        return;
+    }
+    if ((mLayerMask & layers) != 0)
+    {
+        visitor(*this);
+    }
+    for (auto& child : mChildren)
+    {
+        child->traverse(layers, std::forward<Visitor>(visitor));
+    }
+}
+
+template<typename Visitor>
+void Node::traverse(std::uint64_t layers, Visitor&& visitor) const
+{
+    if ((mSubtreeLayerMask & layers) == 0)
+    {
+        return;
+    }
+    if ((mLayerMask & layers) != 0)
+    {
+        visitor(*this);
+    }
+    for (const auto& child : mChildren)
+    {
+        child->traverse(layers, std::forward<Visitor>(visitor));
+    }
+}
+
 }
 
 #endif /* Node_h */
@@ -0,0 +1,81 @@
+//
+//  PoseSet.hpp
+//  eSGraph
+//
+//  Per-instance pose buffers over one shared joint hierarchy
+//
+
+#ifndef PoseSet_h
+#define PoseSet_h
+
+#define GLM_FORCE_XYZW_ONLY
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+#include "glm/gtc/quaternion.hpp"
+#include "InstanceSet.hpp"
+
+namespace eSGraph {
+
+// Many poses of the same hierarchy. The Prototype is the shared topology (parent
+// indices, identifiers, bind pose); each instance only owns its local TRS and world
+// matrix per joint. Storage is joint-major, so the world update walks the joints once
+// and runs a contiguous loop across all instances for each joint.
+class PoseSet
+{
+public:
+    explicit PoseSet(std::shared_ptr<const Prototype> topology);
+
+    [[nodiscard]] const Prototype& getTopology() const noexcept { return *mTopology; }
+    [[nodiscard]] size_t getJointCount() const noexcept { return mTopology->size(); }
+    [[nodiscard]] size_t size() const noexcept { return mSize; }
+
+    void reserve(size_t capacity);
+    // New instances start in the topology's bind pose
+    size_t spawn();
+    // Swap-and-pop: the last instance takes over the removed index
+    void despawn(size_t instance);
+    void clear() noexcept;
+
+    // Local transforms, mirroring Node's LOCAL setters and getters
+    void setPosition(size_t instance, size_t joint, const glm::vec3& position);
+    void setRotation(size_t instance, size_t joint, const glm::quat& rotation);
+    void setScale(size_t instance, size_t joint, const glm::vec3& scale);
+    [[nodiscard]] const glm::vec3& getPosition(size_t instance, size_t joint) const noexcept { return mPositions[slot(instance, joint)]; }
+    [[nodiscard]] const glm::quat& getRotation(size_t instance, size_t joint) const noexcept { return mRotations[slot(instance, joint)]; }
+    [[nodiscard]] const glm::vec3& getScale(size_t instance, size_t joint) const noexcept { return mScales[slot(instance, joint)]; }
+
+    // One joint across all instances (spans hold size() elements, rotations used as given)
+    void setPositions(size_t joint, std::span<const glm::vec3> positions);
+    void setRotations(size_t joint, std::span<const glm::quat> rotations);
+    void setScales(size_t joint, std::span<const glm::vec3> scales);
+    [[nodiscard]] std::span<const glm::vec3> getPositions(size_t joint) const noexcept { return {mPositions.data() + joint * mCapacity, mSize}; }
+    [[nodiscard]] std::span<const glm::quat> getRotations(size_t joint) const noexcept { return {mRotations.data() + joint * mCapacity, mSize}; }
+    [[nodiscard]] std::span<const glm::vec3> getScales(size_t joint) const noexcept { return {mScales.data() + joint * mCapacity, mSize}; }
+
+    // World matrices are recomputed lazily for all instances at once
+    void update();
+    [[nodiscard]] const glm::mat4& getGlobalMatrix(size_t instance, size_t joint);
+    [[nodiscard]] std::span<const glm::mat4> getGlobalMatrices(size_t joint);
+
+private:
+    std::shared_ptr<const Prototype> mTopology;
+    size_t mSize{0};
+    size_t mCapacity{0};
+    bool mDirty{false};
+
+    // joint * mCapacity + instance
+    std::vector<glm::vec3> mPositions;
+    std::vector<glm::quat> mRotations;
+    std::vector<glm::vec3> mScales;
+    std::vector<glm::mat4> mGlobalMatrices;
+
+    [[nodiscard]] size_t slot(size_t instance, size_t joint) const noexcept { return joint * mCapacity + instance; }
+};
+
+}
+
+#endif /* PoseSet_h */
@@ -0,0 +1,120 @@
+//
+//  SceneFormat.hpp
+//  eSGraph
+//
+//  Versioned binary scene format that can be memory-mapped and read in place
+//
+
+#ifndef SceneFormat_h
+#define SceneFormat_h
+
+#define GLM_FORCE_XYZW_ONLY
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "glm/gtc/quaternion.hpp"
+
+namespace eSGraph {
+class Node;
+
+// Layout: header, then 16-byte aligned arrays referenced by byte offsets.
+// Nodes are stored in depth-first pre-order; node 0 is the root and every
+// parent index is smaller than its child's index.
+struct SceneHeader
+{
+    static constexpr std::uint32_t MAGIC = 0x53475345;  // "ESGS"
+    static constexpr std::uint32_t ENDIAN_TAG = 0x01020304;
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr std::uint32_t NO_PARENT = 0xFFFFFFFF;
+
+    std::uint32_t magic{MAGIC};
+    std::uint32_t endianTag{ENDIAN_TAG};
+    std::uint32_t version{VERSION};
+    std::uint32_t nodeCount{0};
+    std::uint32_t identifierCount{0};
+    std::uint32_t stringBytes{0};
+
+    std::uint64_t parentsOffset{0};            // uint32_t[nodeCount]
+    std::uint64_t positionsOffset{0};          // glm::vec3[nodeCount]
+    std::uint64_t rotationsOffset{0};          // glm::quat[nodeCount] (x, y, z, w)
+    std::uint64_t scalesOffset{0};             // glm::vec3[nodeCount]
+    std::uint64_t identifierIndicesOffset{0};  // uint32_t[nodeCount] into the identifier table
+    std::uint64_t identifierOffsetsOffset{0};  // uint32_t[identifierCount + 1] into the string blob
+    std::uint64_t stringsOffset{0};            // char[stringBytes]
+    std::uint64_t totalBytes{0};
+};
+
+class SceneWriter
+{
+public:
+    // Flattens the subtree under root. Identical identifiers are stored once.
+    [[nodiscard]] static std::vector<std::byte> write(const Node& root);
+    static bool writeFile(const Node& root, const std::string& path);
+};
+
+// Non-owning, zero-copy view over serialized scene bytes (e.g. a MappedFile).
+// The underlying buffer must outlive the view.
+class SceneView
+{
+public:
+    // Validates the header, array bounds and indices; returns nullopt on malformed data
+    [[nodiscard]] static std::optional<SceneView> open(std::span<const std::byte> data);
+
+    [[nodiscard]] size_t size() const noexcept { return mParents.size(); }
+    [[nodiscard]] std::span<const std::uint32_t> getParentIndices() const noexcept { return mParents; }
+    [[nodiscard]] std::span<const glm::vec3> getPositions() const noexcept { return mPositions; }
+    [[nodiscard]] std::span<const glm::quat> getRotations() const noexcept { return mRotations; }
+    [[nodiscard]] std::span<const glm::vec3> getScales() const noexcept { return mScales; }
+    [[nodiscard]] std::string_view getIdentifier(size_t index) const noexcept;
+
+    // Bulk conversion into a detached Node tree
+    [[nodiscard]] std::unique_ptr<Node> instantiate() const;
+
+private:
+    SceneView() = default;
+
+    std::span<const std::uint32_t> mParents;
+    std::span<const glm::vec3> mPositions;
+    std::span<const glm::quat> mRotations;
+    std::span<const glm::vec3> mScales;
+    std::span<const std::uint32_t> mIdentifierIndices;
+    std::span<const std::uint32_t> mIdentifierOffsets;
+    const char* mStrings{nullptr};
+};
+
+// Read-only memory mapping of a whole file
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    [[nodiscard]] bool isOpen() const noexcept { return mData != nullptr; }
+    [[nodiscard]] std::span<const std::byte> getData() const noexcept { return {mData, mSize}; }
+
+private:
+    const std::byte* mData{nullptr};
+    size_t mSize{0};
+#if defined(_WIN32)
+    void* mFile{nullptr};
+    void* mMapping{nullptr};
+#endif
+
+    void close() noexcept;
+};
+
+}
+
+#endif /* SceneFormat_h */
@@ -0,0 +1,66 @@
+//
+//  Skeleton.hpp
+//  eSGraph
+//
+//  Skinning palette generation for joints of a Node subtree
+//
+
+#ifndef Skeleton_h
+#define Skeleton_h
+
+#define GLM_FORCE_XYZW_ONLY
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+#include "glm/gtc/quaternion.hpp"
+
+namespace eSGraph {
+class Node;
+
+// Joints are referenced, not owned, and must outlive the skeleton. The palette
+// holds globalMatrix * inverseBindMatrix per joint in a PALETTE_ALIGNMENT-aligned
+// buffer; update() only recomputes joints whose global matrix changed.
+class Skeleton
+{
+public:
+    static constexpr size_t PALETTE_ALIGNMENT = 64;
+
+    // Every node of the subtree in depth-first pre-order, bound in its current pose
+    explicit Skeleton(Node& root);
+    Skeleton(std::vector<Node*> joints, std::span<const glm::mat4> inverseBindMatrices);
+
+    [[nodiscard]] size_t getJointCount() const noexcept { return mJoints.size(); }
+    [[nodiscard]] Node* getJoint(size_t index) const noexcept { return mJoints[index]; }
+    [[nodiscard]] std::span<const glm::mat4> getInverseBindMatrices() const noexcept { return mInverseBindMatrices; }
+
+    // Returns the number of joints whose palette entry was recomputed
+    size_t update();
+    [[nodiscard]] std::span<const glm::mat4> getPalette() const noexcept { return {mPalette.get(), mJoints.size()}; }
+
+private:
+    struct AlignedDelete
+    {
+        void operator()(glm::mat4* palette) const noexcept;
+    };
+
+    std::vector<Node*> mJoints;
+    std::vector<glm::mat4> mInverseBindMatrices;
+    std::unique_ptr<glm::mat4[], AlignedDelete> mPalette;
+
+    // Global matrix version each palette entry was computed from
+    std::vector<std::uint32_t> mVersions;
+    bool mInitialized{false};
+
+    // Scratch for the multiply pass
+    std::vector<std::uint32_t> mChanged;
+    std::vector<glm::mat4> mGlobals;
+
+    void allocatePalette();
+};
+
+}
+
+#endif /* Skeleton_h */
@@ -0,0 +1,95 @@
+//
+//  SpscQueue.hpp
+//  eSGraph
+//
+//  Bounded lock-free single-producer/single-consumer queue
+//
+
+#ifndef SpscQueue_h
+#define SpscQueue_h
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace eSGraph {
+
+// Exactly one thread may push and exactly one (other) thread may pop.
+// T must be default constructible and move assignable.
+template<typename T>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(size_t capacity);
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    [[nodiscard]] size_t capacity() const noexcept { return mSlots.size(); }
+
+    // Producer side; returns false when the queue is full and leaves value untouched
+    bool tryPush(T&& value);
+    // Consumer side; returns false when the queue is empty
+    bool tryPop(T& value);
+
+    [[nodiscard]] bool empty() const noexcept;
+
+private:
+    std::vector<T> mSlots;
+    size_t mMask;
+
+    alignas(64) std::atomic<size_t> mHead{0};  // Next slot to pop, written by the consumer
+    alignas(64) std::atomic<size_t> mTail{0};  // Next slot to push, written by the producer
+};
+
+// Template implementations
+template<typename T>
+SpscQueue<T>::SpscQueue(size_t capacity)
+{
+    size_t size = 1;
+    while (size < capacity)
+    {
+        size <<= 1;
+    }
+    mSlots.resize(size);
+    mMask = size - 1;
+}
+
+template<typename T>
+bool SpscQueue<T>::tryPush(T&& value)
+{
+    const size_t tail = mTail.load(std::memory_order_relaxed);
+    if (tail - mHead.load(std::memory_order_acquire) == mSlots.size())
+    {
+        return false;
+    }
+
+    mSlots[tail & mMask] = std::move(value);
+    mTail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+bool SpscQueue<T>::tryPop(T& value)
+{
+    const size_t head = mHead.load(std::memory_order_relaxed);
+    if (head == mTail.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    value = std::move(mSlots[head & mMask]);
+    mHead.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+bool SpscQueue<T>::empty() const noexcept
+{
+    return mHead.load(std::memory_order_acquire) == mTail.load(std::memory_order_acquire);
+}
+
+}
+
+#endif /* SpscQueue_h */
@@ -0,0 +1,81 @@
+//
+//  StreamingLoader.hpp
+//  eSGraph
+//
+//  Decodes serialized subtrees on a background thread and attaches them under a time budget
+//
+
+#ifndef StreamingLoader_h
+#define StreamingLoader_h
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SpscQueue.hpp"
+
+namespace eSGraph {
+class Node;
+
+class StreamingLoader
+{
+public:
+    // queueCapacity bounds how many decoded subtrees may wait for attachment
+    explicit StreamingLoader(size_t queueCapacity = 64);
+    ~StreamingLoader();
+
+    StreamingLoader(const StreamingLoader&) = delete;
+    StreamingLoader& operator=(const StreamingLoader&) = delete;
+
+    // Main thread. The decoded subtree (binary scene format) is attached under parent,
+    // which must stay alive until the request has been attached.
+    void request(std::vector<std::byte> sceneBytes, Node* parent);
+    void request(std::string scenePath, Node* parent);
+
+    // Main thread. Attaches decoded subtrees with Node::attachTo until the queue is
+    // empty or the budget is spent. At least one subtree is attached if one is ready.
+    size_t update(std::chrono::microseconds budget);
+
+    [[nodiscard]] size_t getPendingCount() const noexcept;
+    [[nodiscard]] size_t getFailedCount() const noexcept { return mFailedCount.load(std::memory_order_acquire); }
+
+private:
+    struct Request
+    {
+        std::vector<std::byte> bytes;
+        std::string path;
+        Node* parent{nullptr};
+    };
+
+    struct Decoded
+    {
+        std::unique_ptr<Node> node;
+        Node* parent{nullptr};
+    };
+
+    SpscQueue<Decoded> mDecoded;
+
+    std::mutex mRequestMutex;
+    std::condition_variable mRequestCondition;
+    std::deque<Request> mRequests;
+    bool mStopping{false};
+
+    size_t mRequestedCount{0};
+    size_t mAttachedCount{0};
+    std::atomic<size_t> mFailedCount{0};
+
+    std::thread mWorker;
+
+    void run();
+    [[nodiscard]] static std::unique_ptr<Node> decode(const Request& request);
+};
+
+}
+
+#endif /* StreamingLoader_h */
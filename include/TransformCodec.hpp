@@ -0,0 +1,100 @@
+//
+//  TransformCodec.hpp
+//  eSGraph
+//
+//  Quantized 12-byte transform encoding for replication and save data
+//
+
+#ifndef TransformCodec_h
+#define TransformCodec_h
+
+#define GLM_FORCE_XYZW_ONLY
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "glm/gtc/quaternion.hpp"
+
+namespace eSGraph {
+class Node;
+
+struct PositionBounds
+{
+    glm::vec3 min{0.0f};
+    glm::vec3 max{0.0f};
+};
+
+// 16-bit range-quantized position, half-float uniform scale and smallest-three
+// rotation: 12 bytes against 40 for full-precision TRS
+struct PackedTransform
+{
+    std::uint16_t position[3];
+    std::uint16_t scale;
+    std::uint32_t rotation;
+};
+static_assert(sizeof(PackedTransform) == 12);
+
+class TransformCodec
+{
+public:
+    // Scale slot marker: the scale is stored in the non-uniform scale stream instead
+    static constexpr std::uint16_t NON_UNIFORM_SCALE = 0xFFFF;
+
+    // Maximum absolute error of each of the three stored quaternion components
+    static constexpr float ROTATION_ERROR = 0.70710678f / 1023.0f;
+    // Maximum relative error of a uniform scale stored as a half float
+    static constexpr float SCALE_RELATIVE_ERROR = 1.0f / 2048.0f;
+    // Relative difference below which y and z count as equal to x
+    static constexpr float UNIFORM_SCALE_TOLERANCE = 1e-5f;
+
+    explicit TransformCodec(const PositionBounds& bounds);
+
+    [[nodiscard]] const PositionBounds& getBounds() const noexcept { return mBounds; }
+    // Maximum absolute error per axis of a position inside the bounds
+    [[nodiscard]] glm::vec3 getPositionError() const noexcept;
+
+    [[nodiscard]] static PositionBounds computeBounds(std::span<const glm::vec3> positions);
+
+    [[nodiscard]] static std::uint32_t packRotation(const glm::quat& rotation) noexcept;
+    [[nodiscard]] static glm::quat unpackRotation(std::uint32_t packed) noexcept;
+    [[nodiscard]] static std::uint16_t packHalf(float value) noexcept;
+    [[nodiscard]] static float unpackHalf(std::uint16_t half) noexcept;
+
+    // Batch encode of parallel TRS arrays. Positions outside the bounds are clamped.
+    // Non-uniform scales are appended to nonUniformScales in record order.
+    void encode(std::span<const glm::vec3> positions,
+                std::span<const glm::quat> rotations,
+                std::span<const glm::vec3> scales,
+                std::span<PackedTransform> out,
+                std::vector<glm::vec3>& nonUniformScales) const;
+
+    // Inverse of encode. Returns false if nonUniformScales has fewer entries than the
+    // records reference.
+    bool decode(std::span<const PackedTransform> packed,
+                std::span<const glm::vec3> nonUniformScales,
+                std::span<glm::vec3> positions,
+                std::span<glm::quat> rotations,
+                std::span<glm::vec3> scales) const;
+
+    // Local transforms of a subtree in pre-order, bounded by the subtree's own positions
+    struct EncodedSubtree
+    {
+        PositionBounds bounds;
+        std::vector<PackedTransform> transforms;
+        std::vector<glm::vec3> nonUniformScales;
+    };
+
+    [[nodiscard]] static EncodedSubtree encodeSubtree(const Node& root);
+    // Writes onto a subtree with the same shape. Returns false on a node count mismatch.
+    static bool decodeSubtree(const EncodedSubtree& encoded, Node& root);
+
+private:
+    PositionBounds mBounds;
+    glm::vec3 mScale;
+    glm::vec3 mInverseScale;
+};
+
+}
+
+#endif /* TransformCodec_h */
@@ -0,0 +1,111 @@
+//
+//  TransformRecorder.hpp
+//  eSGraph
+//
+//  Per-frame change tracking and compact binary transform deltas
+//
+
+#ifndef TransformRecorder_h
+#define TransformRecorder_h
+
+#define GLM_FORCE_XYZW_ONLY
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "glm/gtc/quaternion.hpp"
+
+namespace eSGraph {
+class Node;
+
+enum class TransformComponent : std::uint8_t
+{
+    POSITION = 1 << 0,
+    ROTATION = 1 << 1,
+    SCALE = 1 << 2
+};
+
+// Tracked nodes report local transform changes through Node::setMatrixDirty, so
+// encoding a delta only visits nodes that changed since the previous encode.
+//
+// Delta layout (native byte order):
+//   uint32 frame, varint entryCount, then per entry in ascending id order:
+//   varint idDelta, uint8 componentMask,
+//   [int32 x3 position in units of positionPrecision]
+//   [int16 x4 rotation, normalized x, y, z, w with w >= 0]
+//   [int32 x3 scale in units of scalePrecision]
+//
+// Deltas build on each other, so a receiver applies them strictly in frame order.
+class TransformRecorder
+{
+public:
+    static constexpr std::uint32_t INVALID_ID = 0xFFFFFFFF;
+
+    explicit TransformRecorder(float positionPrecision = 0.001f, float scalePrecision = 0.001f);
+    ~TransformRecorder();
+
+    TransformRecorder(const TransformRecorder&) = delete;
+    TransformRecorder& operator=(const TransformRecorder&) = delete;
+
+    // Ids are assigned in tracking order, so two recorders tracking identical
+    // hierarchies (e.g. on both ends of a connection) agree on them.
+    std::uint32_t track(Node* node);
+    void trackSubtree(Node& root);
+    void untrack(Node* node);
+
+    [[nodiscard]] Node* getNode(std::uint32_t id) const noexcept;
+    [[nodiscard]] std::uint32_t getFrame() const noexcept { return mFrame; }
+    [[nodiscard]] size_t getChangedCount() const noexcept { return mChanged.size(); }
+    [[nodiscard]] float getPositionPrecision() const noexcept { return mPositionPrecision; }
+    [[nodiscard]] float getScalePrecision() const noexcept { return mScalePrecision; }
+    // Frame number the next applied delta must carry
+    [[nodiscard]] std::uint32_t getExpectedFrame() const noexcept { return mExpectedFrame; }
+
+    // Appends the delta since the previous encode to out and starts a new frame
+    void encodeDelta(std::vector<std::uint8_t>& out);
+
+    // Writes a delta back through Node::setLocalTransforms. Applied changes are not
+    // re-recorded. Returns false if the delta is malformed or out of sequence (stale,
+    // repeated or skipping a frame), leaving the nodes and baselines untouched.
+    bool applyDelta(std::span<const std::uint8_t> delta);
+
+private:
+    struct Quantized
+    {
+        std::int32_t position[3];
+        std::int16_t rotation[4];
+        std::int32_t scale[3];
+    };
+
+    float mPositionPrecision;
+    float mScalePrecision;
+    std::uint32_t mFrame{0};
+    std::uint32_t mExpectedFrame{0};
+    bool mApplying{false};
+
+    std::vector<Node*> mNodes;
+    std::vector<Quantized> mBaselines;
+    std::vector<std::uint8_t> mMarked;
+    std::vector<std::uint32_t> mChanged;
+
+    // Scratch buffers for applyDelta; baselines are committed from them only once the
+    // whole delta has been parsed and applied
+    std::vector<std::uint32_t> mApplyIds;
+    std::vector<std::uint8_t> mApplyMasks;
+    std::vector<Quantized> mApplyValues;
+    std::vector<Node*> mApplyNodes;
+    std::vector<glm::vec3> mApplyPositions;
+    std::vector<glm::quat> mApplyRotations;
+    std::vector<glm::vec3> mApplyScales;
+
+    [[nodiscard]] Quantized quantize(const Node& node) const;
+
+    friend class Node;
+    void markChanged(std::uint32_t id);
+    void forget(std::uint32_t id) noexcept;
+};
+
+}
+
+#endif /* TransformRecorder_h */
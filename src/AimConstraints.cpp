@@ -0,0 +1,178 @@
+//
+//  AimConstraints.cpp
+//  eSGraph
+//
+
+#include "AimConstraints.hpp"
+#include "Node.hpp"
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <utility>
+
+using namespace eSGraph;
+
+size_t AimConstraints::add(Node* source, Node* target, const glm::vec3& up, float weight)
+{
+    assert(source != nullptr && target != nullptr);
+    const glm::quat rotation = source->getRotation();
+    mConstraints.push_back({source, target, glm::vec3(0.0f), up, std::clamp(weight, 0.0f, 1.0f),
+                            rotation, rotation});
+    mOrderDirty = true;
+    return mConstraints.size() - 1;
+}
+
+size_t AimConstraints::add(Node* source, const glm::vec3& targetPoint, const glm::vec3& up, float weight)
+{
+    assert(source != nullptr);
+    const glm::quat rotation = source->getRotation();
+    mConstraints.push_back({source, nullptr, targetPoint, up, std::clamp(weight, 0.0f, 1.0f),
+                            rotation, rotation});
+    mOrderDirty = true;
+    return mConstraints.size() - 1;
+}
+
+void AimConstraints::remove(size_t index)
+{
+    assert(index < mConstraints.size());
+    mConstraints[index] = mConstraints.back();
+    mConstraints.pop_back();
+    mOrderDirty = true;
+}
+
+void AimConstraints::clear() noexcept
+{
+    mConstraints.clear();
+    mOrder.clear();
+    mOrderDirty = false;
+}
+
+void AimConstraints::setTarget(size_t index, Node* target)
+{
+    assert(target != nullptr);
+    mConstraints[index].target = target;
+}
+
+void AimConstraints::setTargetPoint(size_t index, const glm::vec3& targetPoint)
+{
+    mConstraints[index].target = nullptr;
+    mConstraints[index].targetPoint = targetPoint;
+}
+
+void AimConstraints::setWeight(size_t index, float weight)
+{
+    mConstraints[index].weight = std::clamp(weight, 0.0f, 1.0f);
+}
+
+void AimConstraints::sortByDepth()
+{
+    struct Key
+    {
+        std::uint32_t depth;
+        const Node* parent;
+        std::uint32_t index;
+    };
+
+    std::vector<Key> keys;
+    keys.reserve(mConstraints.size());
+    for (size_t i = 0; i < mConstraints.size(); ++i)
+    {
+        const Node* parent = mConstraints[i].source->getParent();
+        std::uint32_t depth = 0;
+        for (const Node* node = parent; node; node = node->getParent())
+        {
+            ++depth;
+        }
+        keys.push_back({depth, parent, static_cast<std::uint32_t>(i)});
+    }
+
+    // Siblings end up adjacent so solve() can reuse their parent's world transform
+    std::stable_sort(keys.begin(), keys.end(), [](const Key& a, const Key& b)
+    {
+        if (a.depth != b.depth)
+            return a.depth < b.depth;
+        return std::less<const Node*>()(a.parent, b.parent);
+    });
+
+    mOrder.clear();
+    for (const Key& key : keys)
+    {
+        mOrder.push_back(key.index);
+    }
+    mOrderDirty = false;
+}
+
+void AimConstraints::solve()
+{
+    if (mOrderDirty)
+    {
+        sortByDepth();
+    }
+
+    // A pass only rotates nodes at one depth before moving deeper, so the parent of
+    // a run of siblings cannot change while the run is solved
+    const Node* cachedParent = nullptr;
+    TransformInheritance cachedInheritance = TransformInheritance::ALL;
+    glm::mat4 parentMatrix(1.0f);
+    glm::quat parentRotationInverse = glm::identity<glm::quat>();
+
+    for (std::uint32_t index : mOrder)
+    {
+        Constraint& constraint = mConstraints[index];
+        if (constraint.weight <= 0.0f)
+        {
+            continue;
+        }
+        Node* source = constraint.source;
+        Node* parent = source->getParent();
+
+        if (parent != cachedParent || source->getInheritance() != cachedInheritance)
+        {
+            cachedParent = parent;
+            cachedInheritance = source->getInheritance();
+            parentMatrix = source->getInheritedParentMatrix();
+            parentRotationInverse = glm::conjugate(source->getInheritedParentRotation());
+        }
+
+        // Roots subtract their origin in double like getGlobalMatrix()
+        const glm::vec3 position = parent
+            ? glm::vec3(parentMatrix * glm::vec4(source->getPosition(), 1.0f))
+            : glm::vec3(glm::dvec3(source->getPosition()) - source->getOrigin());
+        const glm::vec3 target = constraint.target
+            ? glm::vec3(constraint.target->getGlobalMatrix()[3])
+            : constraint.targetPoint;
+
+        const glm::vec3 offset = target - position;
+        const float distance = glm::length(offset);
+        if (distance < 1e-6f)
+        {
+            continue;
+        }
+        const glm::vec3 direction = offset / distance;
+
+        const glm::vec3 side = glm::cross(constraint.up, -direction);
+        const float sideLength = glm::length(side);
+        if (sideLength < 1e-6f)
+        {
+            continue;  // Aiming along the up vector leaves the roll undefined
+        }
+        const glm::vec3 right = side / sideLength;
+        const glm::vec3 correctedUp = glm::cross(-direction, right);
+        const glm::quat aim = glm::quat_cast(glm::mat3(right, correctedUp, -direction));
+
+        // Anything but our own last result is a new unconstrained rotation
+        const glm::quat current = source->getRotation();
+        if (current != constraint.written)
+        {
+            constraint.base = current;
+        }
+
+        glm::quat local = parentRotationInverse * aim;
+        if (constraint.weight < 1.0f)
+        {
+            local = glm::slerp(constraint.base, local, constraint.weight);
+        }
+        source->setRotation(local);
+        constraint.written = source->getRotation();
+    }
+}
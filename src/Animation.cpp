@@ -0,0 +1,274 @@
+//
+//  Animation.cpp
+//  eSGraph
+//
+
+#include "Animation.hpp"
+#include "Node.hpp"
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+using namespace eSGraph;
+
+namespace {
+
+constexpr std::uint32_t UNBOUND = std::numeric_limits<std::uint32_t>::max();
+
+glm::vec3 interpolate(const glm::vec3& a, const glm::vec3& b, float t)
+{
+    return glm::mix(a, b, t);
+}
+
+glm::quat interpolate(const glm::quat& a, const glm::quat& b, float t)
+{
+    return glm::slerp(a, b, t);
+}
+
+float difference(const glm::vec3& a, const glm::vec3& b)
+{
+    return glm::length(a - b);
+}
+
+float difference(const glm::quat& a, const glm::quat& b)
+{
+    // q and -q are the same rotation
+    const float sign = glm::dot(a, b) < 0.0f ? -1.0f : 1.0f;
+    return glm::length(glm::vec4(a.x - sign * b.x, a.y - sign * b.y, a.z - sign * b.z, a.w - sign * b.w));
+}
+
+// Finds the segment [key, key + 1] containing time, starting from the previous segment
+std::uint32_t findSegment(std::span<const float> times, std::uint32_t cursor, float time)
+{
+    const auto last = static_cast<std::uint32_t>(times.size() - 1);
+    if (last == 0)
+    {
+        return 0;
+    }
+
+    if (cursor >= last || times[cursor] > time)
+    {
+        const auto upper = std::upper_bound(times.begin(), times.end(), time);
+        cursor = upper == times.begin() ? 0 : static_cast<std::uint32_t>(upper - times.begin() - 1);
+        return std::min(cursor, last - 1);
+    }
+
+    while (cursor + 1 < last && times[cursor + 1] <= time)
+    {
+        ++cursor;
+    }
+    return cursor;
+}
+
+}
+
+AnimationClip::AnimationClip(float duration, float tolerance)
+    : mDuration{duration}
+    , mTolerance{tolerance}
+{
+    assert(duration >= 0.0f);
+    assert(tolerance >= 0.0f);
+}
+
+void AnimationClip::addPositionTrack(std::string_view identifier, std::span<const float> times, std::span<const glm::vec3> values)
+{
+    addTrack(mPositions, identifier, times, values);
+}
+
+void AnimationClip::addRotationTrack(std::string_view identifier, std::span<const float> times, std::span<const glm::quat> values)
+{
+    addTrack(mRotations, identifier, times, values);
+}
+
+void AnimationClip::addScaleTrack(std::string_view identifier, std::span<const float> times, std::span<const glm::vec3> values)
+{
+    addTrack(mScales, identifier, times, values);
+}
+
+size_t AnimationClip::getTrackCount() const noexcept
+{
+    return mPositions.tracks.size() + mRotations.tracks.size() + mScales.tracks.size();
+}
+
+size_t AnimationClip::getKeyCount(AnimationChannel channel) const noexcept
+{
+    switch (channel)
+    {
+        case AnimationChannel::POSITION:
+            return mPositions.values.size();
+        case AnimationChannel::ROTATION:
+            return mRotations.values.size();
+        case AnimationChannel::SCALE:
+            return mScales.values.size();
+    }
+    return 0;
+}
+
+std::uint32_t AnimationClip::internTarget(std::string_view identifier)
+{
+    for (size_t i = 0; i < mTargets.size(); ++i)
+    {
+        if (mTargets[i] == identifier)
+        {
+            return static_cast<std::uint32_t>(i);
+        }
+    }
+    mTargets.emplace_back(identifier);
+    return static_cast<std::uint32_t>(mTargets.size() - 1);
+}
+
+template<typename T>
+void AnimationClip::addTrack(Channel<T>& channel, std::string_view identifier, std::span<const float> times, std::span<const T> values)
+{
+    assert(!times.empty() && times.size() == values.size());
+    assert(std::is_sorted(times.begin(), times.end()));
+
+    // Drop a key when interpolating across it reproduces every skipped key
+    std::vector<size_t> kept{0};
+    for (size_t key = 1; key + 1 < times.size(); ++key)
+    {
+        const size_t anchor = kept.back();
+        const size_t next = key + 1;
+        bool redundant = true;
+        for (size_t skipped = anchor + 1; skipped < next && redundant; ++skipped)
+        {
+            const float interval = times[next] - times[anchor];
+            const float t = interval > 0.0f ? (times[skipped] - times[anchor]) / interval : 0.0f;
+            redundant = difference(interpolate(values[anchor], values[next], t), values[skipped]) <= mTolerance;
+        }
+        if (!redundant)
+        {
+            kept.push_back(key);
+        }
+    }
+    if (times.size() > 1)
+    {
+        kept.push_back(times.size() - 1);
+    }
+    if (kept.size() == 2 && difference(values[kept[0]], values[kept[1]]) <= mTolerance)
+    {
+        kept.pop_back();
+    }
+
+    channel.tracks.push_back({internTarget(identifier),
+                              static_cast<std::uint32_t>(channel.values.size()),
+                              static_cast<std::uint32_t>(kept.size())});
+    for (size_t key : kept)
+    {
+        channel.times.push_back(times[key]);
+        channel.values.push_back(values[key]);
+    }
+}
+
+AnimationBinding::AnimationBinding(const AnimationClip& clip, Node& root)
+    : mClip{clip}
+{
+    // First match in pre-order wins, like a depth-first findByIdentifier from the root
+    std::unordered_map<std::string_view, std::pair<Node*, std::uint32_t>> byIdentifier;
+    std::vector<Node*> stack{&root};
+    std::uint32_t order = 0;
+    while (!stack.empty())
+    {
+        Node* current = stack.back();
+        stack.pop_back();
+        byIdentifier.try_emplace(current->getIdentifier(), current, order++);
+
+        const auto& children = current->getChildren();
+        for (auto it = children.rbegin(); it != children.rend(); ++it)
+        {
+            stack.push_back(it->get());
+        }
+    }
+
+    // Bound nodes are kept in pre-order so parents are written before their children
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> boundTargets;
+    for (size_t target = 0; target < clip.mTargets.size(); ++target)
+    {
+        const auto found = byIdentifier.find(clip.mTargets[target]);
+        if (found != byIdentifier.end())
+        {
+            boundTargets.emplace_back(found->second.second, static_cast<std::uint32_t>(target));
+        }
+    }
+    std::sort(boundTargets.begin(), boundTargets.end());
+
+    std::vector<std::uint32_t> slots(clip.mTargets.size(), UNBOUND);
+    for (const auto& [preOrder, target] : boundTargets)
+    {
+        slots[target] = static_cast<std::uint32_t>(mNodes.size());
+        mNodes.push_back(byIdentifier.at(clip.mTargets[target]).first);
+    }
+
+    auto bindChannel = [&](const auto& channel, std::vector<Target>& targets, std::vector<std::uint32_t>& cursors)
+    {
+        for (size_t track = 0; track < channel.tracks.size(); ++track)
+        {
+            const std::uint32_t slot = slots[channel.tracks[track].target];
+            if (slot == UNBOUND)
+            {
+                ++mUnboundTracks;
+                continue;
+            }
+            targets.push_back({static_cast<std::uint32_t>(track), slot});
+        }
+        cursors.assign(targets.size(), 0);
+    };
+    bindChannel(clip.mPositions, mPositionTargets, mPositionCursors);
+    bindChannel(clip.mRotations, mRotationTargets, mRotationCursors);
+    bindChannel(clip.mScales, mScaleTargets, mScaleCursors);
+
+    mPositions.resize(mNodes.size());
+    mRotations.resize(mNodes.size());
+    mScales.resize(mNodes.size());
+}
+
+void AnimationBinding::apply(float time)
+{
+    time = std::clamp(time, 0.0f, mClip.mDuration);
+
+    // Channels a clip does not animate keep the node's current value
+    for (size_t slot = 0; slot < mNodes.size(); ++slot)
+    {
+        mPositions[slot] = mNodes[slot]->getPosition();
+        mRotations[slot] = mNodes[slot]->getRotation();
+        mScales[slot] = mNodes[slot]->getScale();
+    }
+
+    auto sampleChannel = [&](const auto& channel, const std::vector<Target>& targets,
+                             std::vector<std::uint32_t>& cursors, auto& pose)
+    {
+        // Segment search first, then a tight interpolation loop over the flat key arrays
+        mKeys.resize(targets.size());
+        mBlends.resize(targets.size());
+        for (size_t i = 0; i < targets.size(); ++i)
+        {
+            const auto& track = channel.tracks[targets[i].track];
+            const std::span<const float> times(channel.times.data() + track.firstKey, track.keyCount);
+
+            cursors[i] = findSegment(times, cursors[i], time);
+            mKeys[i] = track.firstKey + cursors[i];
+            if (track.keyCount == 1)
+            {
+                mBlends[i] = 0.0f;
+                continue;
+            }
+            const float start = times[cursors[i]];
+            const float length = times[cursors[i] + 1] - start;
+            mBlends[i] = length > 0.0f ? std::clamp((time - start) / length, 0.0f, 1.0f) : 0.0f;
+        }
+
+        for (size_t i = 0; i < targets.size(); ++i)
+        {
+            const std::uint32_t key = mKeys[i];
+            const std::uint32_t next = mBlends[i] > 0.0f ? key + 1 : key;
+            pose[targets[i].slot] = interpolate(channel.values[key], channel.values[next], mBlends[i]);
+        }
+    };
+    sampleChannel(mClip.mPositions, mPositionTargets, mPositionCursors, mPositions);
+    sampleChannel(mClip.mRotations, mRotationTargets, mRotationCursors, mRotations);
+    sampleChannel(mClip.mScales, mScaleTargets, mScaleCursors, mScales);
+
+    Node::setLocalTransforms(mNodes, mPositions, mRotations, mScales);
+}
@@ -0,0 +1,370 @@
+//
+//  ConstraintStage.cpp
+//  eSGraph
+//
+
+#include "ConstraintStage.hpp"
+#include "Node.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+
+using namespace eSGraph;
+
+namespace {
+
+constexpr float EPSILON = 1e-6f;
+
+glm::mat4 composeMatrix(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale)
+{
+    const glm::mat3 basis = glm::mat3_cast(rotation);
+    return glm::mat4(glm::vec4(basis[0] * scale.x, 0.0f),
+                     glm::vec4(basis[1] * scale.y, 0.0f),
+                     glm::vec4(basis[2] * scale.z, 0.0f),
+                     glm::vec4(position, 1.0f));
+}
+
+// Assumes the matrix has no shear, which holds unless a non-uniform scale sits above
+// a rotated node
+void decomposeMatrix(const glm::mat4& matrix, glm::vec3& position, glm::quat& rotation, glm::vec3& scale)
+{
+    position = glm::vec3(matrix[3]);
+    scale = glm::vec3(glm::length(glm::vec3(matrix[0])),
+                      glm::length(glm::vec3(matrix[1])),
+                      glm::length(glm::vec3(matrix[2])));
+
+    glm::mat3 basis(1.0f);
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (scale[axis] > EPSILON)
+        {
+            basis[axis] = glm::vec3(matrix[axis]) / scale[axis];
+        }
+    }
+    rotation = glm::normalize(glm::quat_cast(basis));
+}
+
+glm::quat getParentRotation(const Node& node)
+{
+    return node.getInheritedParentRotation();
+}
+
+// Rebuilt from the parent every time so that last frame's override never feeds back
+glm::mat4 getUnconstrainedMatrix(Node& node)
+{
+    return node.applyInheritedParentMatrix(node.getMatrix());
+}
+
+// Shortest rotation taking unit vector from onto unit vector to
+glm::quat rotationBetween(const glm::vec3& from, const glm::vec3& to)
+{
+    const glm::vec3 axis = glm::cross(from, to);
+    const float sine = glm::length(axis);
+    if (sine < EPSILON)
+    {
+        return glm::identity<glm::quat>();
+    }
+    const float angle = std::atan2(sine, glm::dot(from, to));
+    return glm::angleAxis(angle, axis / sine);
+}
+
+float angleBetween(const glm::vec3& a, const glm::vec3& b)
+{
+    return std::acos(std::clamp(glm::dot(a, b), -1.0f, 1.0f));
+}
+
+}
+
+size_t ConstraintStage::add(const Constraint& constraint)
+{
+    mConstraints.push_back(constraint);
+    mConstraints.back().weight = std::clamp(constraint.weight, 0.0f, 1.0f);
+    mOrderDirty = true;
+    return mConstraints.size() - 1;
+}
+
+size_t ConstraintStage::addParentConstraint(Node* node, Node* target, float weight, bool maintainOffset)
+{
+    assert(node != nullptr && target != nullptr);
+    const glm::mat4 offset = maintainOffset
+        ? glm::inverse(target->getGlobalMatrix()) * getUnconstrainedMatrix(*node)
+        : glm::mat4(1.0f);
+    return add({ConstraintType::PARENT, weight, node, target, nullptr, nullptr, offset});
+}
+
+size_t ConstraintStage::addPositionConstraint(Node* node, Node* target, float weight)
+{
+    assert(node != nullptr && target != nullptr);
+    return add({ConstraintType::POSITION, weight, node, target, nullptr, nullptr, glm::mat4(1.0f)});
+}
+
+size_t ConstraintStage::addOrientationConstraint(Node* node, Node* target, float weight)
+{
+    assert(node != nullptr && target != nullptr);
+    return add({ConstraintType::ORIENTATION, weight, node, target, nullptr, nullptr, glm::mat4(1.0f)});
+}
+
+size_t ConstraintStage::addTwoBoneIK(Node* upper, Node* middle, Node* end, Node* target, float weight)
+{
+    assert(upper != nullptr && middle != nullptr && end != nullptr && target != nullptr);
+    assert(middle->getParent() == upper && end->getParent() == middle);
+    return add({ConstraintType::TWO_BONE_IK, weight, upper, target, middle, end, glm::mat4(1.0f)});
+}
+
+void ConstraintStage::remove(size_t index)
+{
+    assert(index < mConstraints.size());
+    mConstraints[index] = mConstraints.back();
+    mConstraints.pop_back();
+    mOrderDirty = true;
+}
+
+void ConstraintStage::clear() noexcept
+{
+    mConstraints.clear();
+    mOrder.clear();
+    mOrderDirty = false;
+}
+
+void ConstraintStage::setWeight(size_t index, float weight)
+{
+    mConstraints[index].weight = std::clamp(weight, 0.0f, 1.0f);
+}
+
+void ConstraintStage::sortByDependencies()
+{
+    const size_t count = mConstraints.size();
+
+    std::unordered_map<const Node*, std::uint32_t> writers;
+    for (size_t i = 0; i < count; ++i)
+    {
+        writers.emplace(mConstraints[i].node, static_cast<std::uint32_t>(i));
+        if (mConstraints[i].middle)
+        {
+            writers.emplace(mConstraints[i].middle, static_cast<std::uint32_t>(i));
+        }
+    }
+
+    // Edge writer -> reader when a constraint reads a node at or below what another writes
+    std::vector<std::vector<std::uint32_t>> dependents(count);
+    std::vector<std::uint32_t> pending(count, 0);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Constraint& constraint = mConstraints[i];
+        std::vector<std::uint32_t> sources;
+        for (const Node* read : {static_cast<const Node*>(constraint.target), static_cast<const Node*>(constraint.node->getParent())})
+        {
+            for (const Node* node = read; node; node = node->getParent())
+            {
+                const auto writer = writers.find(node);
+                if (writer != writers.end() && writer->second != i)
+                {
+                    sources.push_back(writer->second);
+                }
+            }
+        }
+        std::sort(sources.begin(), sources.end());
+        sources.erase(std::unique(sources.begin(), sources.end()), sources.end());
+        for (std::uint32_t source : sources)
+        {
+            dependents[source].push_back(static_cast<std::uint32_t>(i));
+        }
+        pending[i] = static_cast<std::uint32_t>(sources.size());
+    }
+
+    // Kahn's algorithm, ties broken by registration order
+    std::priority_queue<std::uint32_t, std::vector<std::uint32_t>, std::greater<>> ready;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (pending[i] == 0)
+        {
+            ready.push(static_cast<std::uint32_t>(i));
+        }
+    }
+
+    mOrder.clear();
+    std::vector<std::uint8_t> placed(count, 0);
+    while (!ready.empty())
+    {
+        const std::uint32_t index = ready.top();
+        ready.pop();
+        mOrder.push_back(index);
+        placed[index] = 1;
+        for (std::uint32_t dependent : dependents[index])
+        {
+            if (--pending[dependent] == 0)
+            {
+                ready.push(dependent);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!placed[i])
+        {
+            mOrder.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+    mOrderDirty = false;
+}
+
+void ConstraintStage::evaluate()
+{
+    if (mOrderDirty)
+    {
+        sortByDependencies();
+    }
+
+    for (std::uint32_t index : mOrder)
+    {
+        const Constraint& constraint = mConstraints[index];
+        if (constraint.weight <= 0.0f)
+        {
+            continue;
+        }
+
+        switch (constraint.type)
+        {
+            case ConstraintType::PARENT:
+                evaluateParent(constraint);
+                break;
+            case ConstraintType::POSITION:
+                evaluatePosition(constraint);
+                break;
+            case ConstraintType::ORIENTATION:
+                evaluateOrientation(constraint);
+                break;
+            case ConstraintType::TWO_BONE_IK:
+                evaluateTwoBoneIK(constraint);
+                break;
+        }
+    }
+}
+
+void ConstraintStage::evaluateParent(const Constraint& constraint)
+{
+    Node& node = *constraint.node;
+    const glm::mat4 followed = constraint.target->getGlobalMatrix() * constraint.offset;
+
+    glm::vec3 position;
+    glm::quat rotation;
+    glm::vec3 scale;
+    decomposeMatrix(followed, position, rotation, scale);
+
+    if (constraint.weight < 1.0f)
+    {
+        glm::vec3 ownPosition;
+        glm::quat ownRotation;
+        glm::vec3 ownScale;
+        decomposeMatrix(getUnconstrainedMatrix(node), ownPosition, ownRotation, ownScale);
+
+        position = glm::mix(ownPosition, position, constraint.weight);
+        rotation = glm::slerp(ownRotation, rotation, constraint.weight);
+        scale = glm::mix(ownScale, scale, constraint.weight);
+        node.overrideGlobalTransform(composeMatrix(position, rotation, scale), rotation);
+        return;
+    }
+    node.overrideGlobalTransform(followed, rotation);
+}
+
+void ConstraintStage::evaluatePosition(const Constraint& constraint)
+{
+    Node& node = *constraint.node;
+    glm::mat4 world = getUnconstrainedMatrix(node);
+
+    const glm::vec3 target(constraint.target->getGlobalMatrix()[3]);
+    world[3] = glm::vec4(glm::mix(glm::vec3(world[3]), target, constraint.weight), 1.0f);
+
+    node.overrideGlobalTransform(world, getParentRotation(node) * node.getRotation());
+}
+
+void ConstraintStage::evaluateOrientation(const Constraint& constraint)
+{
+    Node& node = *constraint.node;
+
+    glm::vec3 position;
+    glm::quat rotation;
+    glm::vec3 scale;
+    decomposeMatrix(getUnconstrainedMatrix(node), position, rotation, scale);
+
+    const glm::quat ownRotation = getParentRotation(node) * node.getRotation();
+    rotation = glm::slerp(ownRotation, constraint.target->getRotation(Coordinates::WORLD), constraint.weight);
+
+    node.overrideGlobalTransform(composeMatrix(position, rotation, scale), rotation);
+}
+
+void ConstraintStage::evaluateTwoBoneIK(const Constraint& constraint)
+{
+    Node& upper = *constraint.node;
+    Node& middle = *constraint.middle;
+    Node& end = *constraint.end;
+
+    const glm::quat parentRotation = getParentRotation(upper);
+    const glm::mat4 upperMatrix = upper.applyInheritedParentMatrix(upper.getMatrix());
+    const glm::mat4 middleMatrix = upperMatrix * middle.getMatrix();
+    const glm::mat4 endMatrix = middleMatrix * end.getMatrix();
+
+    const glm::vec3 a(upperMatrix[3]);
+    const glm::vec3 b(middleMatrix[3]);
+    const glm::vec3 c(endMatrix[3]);
+    const glm::vec3 t(constraint.target->getGlobalMatrix()[3]);
+
+    const float upperLength = glm::length(b - a);
+    const float lowerLength = glm::length(c - b);
+    const float reach = glm::length(c - a);
+    if (upperLength < EPSILON || lowerLength < EPSILON || reach < EPSILON)
+    {
+        return;
+    }
+    const float targetDistance = std::clamp(glm::length(t - a), EPSILON, upperLength + lowerLength - EPSILON);
+
+    // Interior angles now and after solving the triangle with side targetDistance
+    const float upperAngle = angleBetween((c - a) / reach, (b - a) / upperLength);
+    const float middleAngle = angleBetween((a - b) / upperLength, (c - b) / lowerLength);
+    const float solvedUpperAngle = std::acos(std::clamp(
+        (lowerLength * lowerLength - upperLength * upperLength - targetDistance * targetDistance) /
+        (-2.0f * upperLength * targetDistance), -1.0f, 1.0f));
+    const float solvedMiddleAngle = std::acos(std::clamp(
+        (targetDistance * targetDistance - upperLength * upperLength - lowerLength * lowerLength) /
+        (-2.0f * upperLength * lowerLength), -1.0f, 1.0f));
+
+    // Bend in the current chain plane; a straight chain bends about an arbitrary normal
+    glm::vec3 bendAxis = glm::cross(c - a, b - a);
+    if (glm::length(bendAxis) < EPSILON)
+    {
+        const glm::vec3 direction = (c - a) / reach;
+        const glm::vec3 helper = std::abs(direction.y) < 0.9f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+        bendAxis = glm::cross(direction, helper);
+    }
+    bendAxis = glm::normalize(bendAxis);
+
+    // The bend keeps the end on the current upper-to-end line; the swing then turns
+    // that line onto the target
+    const glm::quat upperBend = glm::angleAxis(solvedUpperAngle - upperAngle, bendAxis);
+    const glm::quat middleBend = glm::angleAxis(solvedMiddleAngle - middleAngle, bendAxis);
+    const glm::quat swing = glm::length(t - a) > EPSILON
+        ? rotationBetween((c - a) / reach, glm::normalize(t - a))
+        : glm::identity<glm::quat>();
+
+    const glm::quat upperRotation = parentRotation * upper.getRotation();
+    const glm::quat middleRotation = upperRotation * middle.getRotation();
+    glm::quat solvedUpper = swing * upperBend * upperRotation;
+    glm::quat solvedMiddle = swing * middleBend * upperBend * middleRotation;
+    if (constraint.weight < 1.0f)
+    {
+        solvedUpper = glm::slerp(upperRotation, solvedUpper, constraint.weight);
+        solvedMiddle = glm::slerp(middleRotation, solvedMiddle, constraint.weight);
+    }
+
+    const glm::mat4 solvedUpperMatrix = upper.applyInheritedParentMatrix(
+        composeMatrix(upper.getPosition(), glm::conjugate(parentRotation) * solvedUpper, upper.getScale()));
+    const glm::mat4 solvedMiddleMatrix = solvedUpperMatrix *
+        composeMatrix(middle.getPosition(), glm::conjugate(solvedUpper) * solvedMiddle, middle.getScale());
+
+    upper.overrideGlobalTransform(solvedUpperMatrix, solvedUpper);
+    middle.overrideGlobalTransform(solvedMiddleMatrix, solvedMiddle);
+}
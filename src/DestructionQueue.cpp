@@ -0,0 +1,144 @@
+//
+//  DestructionQueue.cpp
+//  eSGraph
+//
+
+#include "DestructionQueue.hpp"
+#include "Node.hpp"
+#include <cassert>
+#include <utility>
+
+using namespace eSGraph;
+
+namespace {
+
+// Clock reads are not free; only check the budget every few nodes
+constexpr size_t BUDGET_CHECK_INTERVAL = 64;
+
+}
+
+DestructionQueue::DestructionQueue(DestructionMode mode)
+    : mMode{mode}
+{
+    if (mMode == DestructionMode::BACKGROUND)
+    {
+        mWorker = std::thread(&DestructionQueue::run, this);
+    }
+}
+
+DestructionQueue::~DestructionQueue()
+{
+    if (mWorker.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+        mCondition.notify_one();
+        mWorker.join();
+    }
+    while (!mPending.empty())
+    {
+        destroyOne(mPending);
+    }
+}
+
+void DestructionQueue::push(std::unique_ptr<Node> subtree)
+{
+    assert(subtree && !subtree->hasParent());
+#ifndef NDEBUG
+    if (mMode == DestructionMode::BACKGROUND)
+    {
+        subtree->traverse([](const Node& node) {
+            assert(node.mRecorder == nullptr && node.mMotionHistory == nullptr);
+        });
+    }
+#endif
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPending.push_back(std::move(subtree));
+    }
+    mCondition.notify_one();
+}
+
+size_t DestructionQueue::update(std::chrono::microseconds budget)
+{
+    assert(mMode == DestructionMode::TIME_SLICED);
+    const auto start = std::chrono::steady_clock::now();
+    // Held for the whole slice, so a concurrent push() waits at most one budget
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    size_t destroyed = 0;
+    while (!mPending.empty())
+    {
+        destroyOne(mPending);
+        ++destroyed;
+
+        if (destroyed % BUDGET_CHECK_INTERVAL == 0 && std::chrono::steady_clock::now() - start >= budget)
+        {
+            break;
+        }
+    }
+    return destroyed;
+}
+
+void DestructionQueue::flush()
+{
+    if (mMode == DestructionMode::BACKGROUND)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mDrained.wait(lock, [this] { return mPending.empty() && !mBusy; });
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    while (!mPending.empty())
+    {
+        destroyOne(mPending);
+    }
+}
+
+size_t DestructionQueue::getPendingCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mPending.size();
+}
+
+void DestructionQueue::run()
+{
+    std::vector<std::unique_ptr<Node>> local;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mBusy = false;
+            if (mPending.empty())
+            {
+                mDrained.notify_all();
+            }
+            mCondition.wait(lock, [this] { return mStopping || !mPending.empty(); });
+            if (mPending.empty())
+            {
+                return;  // Stopping with nothing left
+            }
+            // Take the whole batch so pushes never wait on the destruction itself
+            local.swap(mPending);
+            mBusy = true;
+        }
+
+        while (!local.empty())
+        {
+            destroyOne(local);
+        }
+    }
+}
+
+void DestructionQueue::destroyOne(std::vector<std::unique_ptr<Node>>& pending)
+{
+    std::unique_ptr<Node> node = std::move(pending.back());
+    pending.pop_back();
+    for (auto& child : node->mChildren)
+    {
+        pending.push_back(std::move(child));
+    }
+    node->mChildren.clear();
+}
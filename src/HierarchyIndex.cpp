@@ -0,0 +1,75 @@
+//
+//  HierarchyIndex.cpp
+//  eSGraph
+//
+
+#include "HierarchyIndex.hpp"
+#include "Node.hpp"
+#include <cassert>
+
+using namespace eSGraph;
+
+HierarchyIndex::HierarchyIndex(Node& root)
+    : mRoot{root}
+{
+    assert(!root.hasParent());
+}
+
+bool HierarchyIndex::isStale() const noexcept
+{
+    return !mBuilt || Node::sStructureEpoch.load(std::memory_order_relaxed) != mBuiltVersion;
+}
+
+void HierarchyIndex::rebuild()
+{
+    assert(!mRoot.hasParent());
+
+    mStack.clear();
+    mOrder.clear();
+    mStack.push_back(&mRoot);
+    mRoot.mTourDepth = 0;
+
+    while (!mStack.empty())
+    {
+        Node* current = mStack.back();
+        mStack.pop_back();
+        current->mTourEnter = static_cast<std::uint32_t>(mOrder.size());
+        mOrder.push_back(current);
+
+        for (auto it = current->mChildren.rbegin(); it != current->mChildren.rend(); ++it)
+        {
+            (*it)->mTourDepth = current->mTourDepth + 1;
+            mStack.push_back(it->get());
+        }
+    }
+
+    // Reverse pre-order reaches every descendant before its ancestor, so each
+    // interval can end where its last child's interval ends
+    for (auto it = mOrder.rbegin(); it != mOrder.rend(); ++it)
+    {
+        Node* node = *it;
+        node->mTourExit = node->mChildren.empty() ? node->mTourEnter : node->mChildren.back()->mTourExit;
+    }
+
+    mSize = mOrder.size();
+    mBuiltVersion = Node::sStructureEpoch.load(std::memory_order_relaxed);
+    mBuilt = true;
+}
+
+bool HierarchyIndex::isAncestorOf(const Node& ancestor, const Node& node)
+{
+    refresh();
+    return ancestor.mTourEnter < node.mTourEnter && node.mTourEnter <= ancestor.mTourExit;
+}
+
+std::uint32_t HierarchyIndex::getDepth(const Node& node)
+{
+    refresh();
+    return node.mTourDepth;
+}
+
+std::uint32_t HierarchyIndex::getSubtreeSize(const Node& node)
+{
+    refresh();
+    return node.mTourExit - node.mTourEnter + 1;
+}
@@ -0,0 +1,295 @@
+//
+//  InstanceSet.cpp
+//  eSGraph
+//
+
+#include "InstanceSet.hpp"
+#include "Node.hpp"
+#include <cassert>
+#include <utility>
+
+using namespace eSGraph;
+
+namespace {
+
+glm::mat4 composeMatrix(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale)
+{
+    return glm::translate(glm::identity<glm::mat4>(), position) *
+           glm::mat4_cast(rotation) *
+           glm::scale(glm::identity<glm::mat4>(), scale);
+}
+
+void computeModelMatrices(std::span<const std::uint32_t> parents,
+                          std::span<const glm::vec3> positions,
+                          std::span<const glm::quat> rotations,
+                          std::span<const glm::vec3> scales,
+                          std::span<glm::mat4> out)
+{
+    out[0] = glm::identity<glm::mat4>();
+    for (size_t i = 1; i < parents.size(); ++i)
+    {
+        out[i] = out[parents[i]] * composeMatrix(positions[i], rotations[i], scales[i]);
+    }
+}
+
+}
+
+Prototype::Prototype(const Node& root)
+{
+    std::vector<std::pair<const Node*, std::uint32_t>> stack;
+    stack.emplace_back(&root, NO_PARENT);
+
+    while (!stack.empty())
+    {
+        auto [node, parent] = stack.back();
+        stack.pop_back();
+
+        const auto index = static_cast<std::uint32_t>(mParents.size());
+        mParents.push_back(parent);
+        mIdentifiers.emplace_back(node->getIdentifier());
+        mPositions.push_back(node->getPosition());
+        mRotations.push_back(node->getRotation());
+        mScales.push_back(node->getScale());
+
+        const auto& children = node->getChildren();
+        for (auto it = children.rbegin(); it != children.rend(); ++it)
+        {
+            stack.emplace_back(it->get(), index);
+        }
+    }
+
+    mModelMatrices.resize(mParents.size());
+    computeModelMatrices(mParents, mPositions, mRotations, mScales, mModelMatrices);
+}
+
+size_t Prototype::find(std::string_view identifier) const noexcept
+{
+    for (size_t i = 0; i < mIdentifiers.size(); ++i)
+    {
+        if (mIdentifiers[i] == identifier)
+        {
+            return i;
+        }
+    }
+    return NOT_FOUND;
+}
+
+InstanceSet::InstanceSet(std::shared_ptr<const Prototype> prototype)
+    : mPrototype{std::move(prototype)}
+{
+    assert(mPrototype && mPrototype->size() > 0);
+}
+
+size_t InstanceSet::spawn(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale)
+{
+    mPositions.push_back(position);
+    mRotations.push_back(glm::normalize(rotation));
+    mScales.push_back(scale);
+    mEditSlots.push_back(NO_EDIT);
+    return mPositions.size() - 1;
+}
+
+void InstanceSet::despawn(size_t instance)
+{
+    assert(instance < size());
+
+    revert(instance);
+
+    const size_t last = size() - 1;
+    if (instance != last)
+    {
+        mPositions[instance] = mPositions[last];
+        mRotations[instance] = mRotations[last];
+        mScales[instance] = mScales[last];
+        mEditSlots[instance] = mEditSlots[last];
+        if (mEditSlots[instance] != NO_EDIT)
+        {
+            mEdits[mEditSlots[instance]].instance = instance;
+        }
+    }
+
+    mPositions.pop_back();
+    mRotations.pop_back();
+    mScales.pop_back();
+    mEditSlots.pop_back();
+}
+
+void InstanceSet::clear()
+{
+    mPositions.clear();
+    mRotations.clear();
+    mScales.clear();
+    mEditSlots.clear();
+    mEdits.clear();
+}
+
+void InstanceSet::setPosition(size_t instance, const glm::vec3& position)
+{
+    mPositions[instance] = position;
+}
+
+void InstanceSet::setRotation(size_t instance, const glm::quat& rotation)
+{
+    mRotations[instance] = glm::normalize(rotation);
+}
+
+void InstanceSet::setScale(size_t instance, const glm::vec3& scale)
+{
+    mScales[instance] = scale;
+}
+
+glm::mat4 InstanceSet::getRootMatrix(size_t instance) const
+{
+    return composeMatrix(mPositions[instance], mRotations[instance], mScales[instance]);
+}
+
+InstanceSet::Edit& InstanceSet::editFor(size_t instance)
+{
+    assert(instance < size());
+
+    if (mEditSlots[instance] == NO_EDIT)
+    {
+        mEditSlots[instance] = static_cast<std::uint32_t>(mEdits.size());
+
+        Edit& edit = mEdits.emplace_back();
+        edit.instance = instance;
+        for (size_t i = 0; i < mPrototype->size(); ++i)
+        {
+            edit.positions.push_back(mPrototype->getPosition(i));
+            edit.rotations.push_back(mPrototype->getRotation(i));
+            edit.scales.push_back(mPrototype->getScale(i));
+        }
+        edit.modelMatrices.resize(mPrototype->size());
+    }
+    return mEdits[mEditSlots[instance]];
+}
+
+void InstanceSet::setLocalPosition(size_t instance, size_t node, const glm::vec3& position)
+{
+    assert(node > 0 && node < mPrototype->size());
+    Edit& edit = editFor(instance);
+    edit.positions[node] = position;
+    edit.modelMatricesDirty = true;
+}
+
+void InstanceSet::setLocalRotation(size_t instance, size_t node, const glm::quat& rotation)
+{
+    assert(node > 0 && node < mPrototype->size());
+    Edit& edit = editFor(instance);
+    edit.rotations[node] = glm::normalize(rotation);
+    edit.modelMatricesDirty = true;
+}
+
+void InstanceSet::setLocalScale(size_t instance, size_t node, const glm::vec3& scale)
+{
+    assert(node > 0 && node < mPrototype->size());
+    Edit& edit = editFor(instance);
+    edit.scales[node] = scale;
+    edit.modelMatricesDirty = true;
+}
+
+const glm::vec3& InstanceSet::getLocalPosition(size_t instance, size_t node) const
+{
+    const std::uint32_t slot = mEditSlots[instance];
+    return slot == NO_EDIT ? mPrototype->getPosition(node) : mEdits[slot].positions[node];
+}
+
+const glm::quat& InstanceSet::getLocalRotation(size_t instance, size_t node) const
+{
+    const std::uint32_t slot = mEditSlots[instance];
+    return slot == NO_EDIT ? mPrototype->getRotation(node) : mEdits[slot].rotations[node];
+}
+
+const glm::vec3& InstanceSet::getLocalScale(size_t instance, size_t node) const
+{
+    const std::uint32_t slot = mEditSlots[instance];
+    return slot == NO_EDIT ? mPrototype->getScale(node) : mEdits[slot].scales[node];
+}
+
+void InstanceSet::revert(size_t instance)
+{
+    const std::uint32_t slot = mEditSlots[instance];
+    if (slot == NO_EDIT)
+    {
+        return;
+    }
+
+    const auto last = static_cast<std::uint32_t>(mEdits.size() - 1);
+    if (slot != last)
+    {
+        mEdits[slot] = std::move(mEdits[last]);
+        mEditSlots[mEdits[slot].instance] = slot;
+    }
+    mEdits.pop_back();
+    mEditSlots[instance] = NO_EDIT;
+}
+
+std::span<const glm::mat4> InstanceSet::getModelMatrices(size_t instance)
+{
+    const std::uint32_t slot = mEditSlots[instance];
+    if (slot == NO_EDIT)
+    {
+        return mPrototype->getModelMatrices();
+    }
+
+    Edit& edit = mEdits[slot];
+    if (edit.modelMatricesDirty)
+    {
+        computeModelMatrices(mPrototype->getParentIndices(), edit.positions, edit.rotations, edit.scales,
+                             edit.modelMatrices);
+        edit.modelMatricesDirty = false;
+    }
+    return edit.modelMatrices;
+}
+
+glm::mat4 InstanceSet::getGlobalMatrix(size_t instance, size_t node)
+{
+    return getRootMatrix(instance) * getModelMatrices(instance)[node];
+}
+
+void InstanceSet::computeGlobalMatrices(size_t instance, std::span<glm::mat4> out)
+{
+    assert(out.size() >= mPrototype->size());
+
+    const glm::mat4 root = getRootMatrix(instance);
+    const std::span<const glm::mat4> model = getModelMatrices(instance);
+    for (size_t i = 0; i < model.size(); ++i)
+    {
+        out[i] = root * model[i];
+    }
+}
+
+void InstanceSet::computeAllGlobalMatrices(std::span<glm::mat4> out)
+{
+    const size_t nodeCount = mPrototype->size();
+    assert(out.size() >= size() * nodeCount);
+
+    for (size_t instance = 0; instance < size(); ++instance)
+    {
+        computeGlobalMatrices(instance, out.subspan(instance * nodeCount, nodeCount));
+    }
+}
+
+std::unique_ptr<Node> InstanceSet::instantiate(size_t instance) const
+{
+    const size_t nodeCount = mPrototype->size();
+    std::vector<Node*> created(nodeCount, nullptr);
+
+    auto root = std::make_unique<Node>(std::string(mPrototype->getIdentifier(0)));
+    root->setPosition(mPositions[instance]);
+    root->setRotation(mRotations[instance]);
+    root->setScale(mScales[instance]);
+    created[0] = root.get();
+
+    for (size_t i = 1; i < nodeCount; ++i)
+    {
+        auto node = std::make_unique<Node>(std::string(mPrototype->getIdentifier(i)));
+        node->setPosition(getLocalPosition(instance, i));
+        node->setRotation(getLocalRotation(instance, i));
+        node->setScale(getLocalScale(instance, i));
+        created[i] = node.get();
+        created[mPrototype->getParentIndex(i)]->addChild(std::move(node));
+    }
+
+    return root;
+}
@@ -0,0 +1,81 @@
+//
+//  InterpolationBuffer.cpp
+//  eSGraph
+//
+
+#include "InterpolationBuffer.hpp"
+#include "Node.hpp"
+#include <cassert>
+#include <utility>
+
+using namespace eSGraph;
+
+InterpolationBuffer::InterpolationBuffer(Node& root)
+{
+    std::vector<std::pair<Node*, std::uint32_t>> stack;
+    stack.emplace_back(&root, NO_PARENT);
+
+    while (!stack.empty())
+    {
+        auto [node, parent] = stack.back();
+        stack.pop_back();
+
+        const auto index = static_cast<std::uint32_t>(mNodes.size());
+        mNodes.push_back(node);
+        mParents.push_back(parent);
+
+        const auto& children = node->getChildren();
+        for (auto it = children.rbegin(); it != children.rend(); ++it)
+        {
+            stack.emplace_back(it->get(), index);
+        }
+    }
+
+    read(mCurrent);
+    mPrevious = mCurrent;
+}
+
+void InterpolationBuffer::read(Snapshot& snapshot)
+{
+    snapshot.positions.resize(mNodes.size());
+    snapshot.rotations.resize(mNodes.size());
+    snapshot.scales.resize(mNodes.size());
+    for (size_t i = 0; i < mNodes.size(); ++i)
+    {
+        snapshot.positions[i] = mNodes[i]->getPosition();
+        snapshot.rotations[i] = mNodes[i]->getRotation();
+        snapshot.scales[i] = mNodes[i]->getScale();
+    }
+
+    Node* parent = mNodes.front()->getParent();
+    mParentMatrix = parent ? parent->getGlobalMatrix() : glm::mat4(1.0f);
+}
+
+void InterpolationBuffer::capture()
+{
+    // Reuse the older snapshot's storage for the new tick
+    std::swap(mPrevious, mCurrent);
+    read(mCurrent);
+}
+
+void InterpolationBuffer::interpolate(float alpha, std::span<glm::mat4> out) const
+{
+    assert(out.size() == mNodes.size());
+
+    for (size_t i = 0; i < mNodes.size(); ++i)
+    {
+        const glm::vec3 position = glm::mix(mPrevious.positions[i], mCurrent.positions[i], alpha);
+        const glm::quat rotation = glm::slerp(mPrevious.rotations[i], mCurrent.rotations[i], alpha);
+        const glm::vec3 scale = glm::mix(mPrevious.scales[i], mCurrent.scales[i], alpha);
+
+        const glm::mat3 basis = glm::mat3_cast(rotation);
+        const glm::mat4 local(glm::vec4(basis[0] * scale.x, 0.0f),
+                              glm::vec4(basis[1] * scale.y, 0.0f),
+                              glm::vec4(basis[2] * scale.z, 0.0f),
+                              glm::vec4(position, 1.0f));
+
+        // Pre-order: the parent's interpolated matrix is already in out
+        const std::uint32_t parent = mParents[i];
+        out[i] = (parent == NO_PARENT ? mParentMatrix : out[parent]) * local;
+    }
+}
@@ -0,0 +1,111 @@
+//
+//  LodSelector.cpp
+//  eSGraph
+//
+
+#include "LodSelector.hpp"
+#include "Node.hpp"
+#include <cassert>
+#include <limits>
+
+using namespace eSGraph;
+
+LodSelector::LodSelector(float hysteresis)
+    : mHysteresis{hysteresis}
+{
+    assert(hysteresis >= 0.0f && hysteresis < 1.0f);
+}
+
+size_t LodSelector::addNode(Node* node, std::span<const float> switchDistances)
+{
+    assert(node != nullptr);
+    assert(switchDistances.size() < std::numeric_limits<std::uint8_t>::max());
+
+    mThresholdOffsets.push_back(static_cast<std::uint32_t>(mSquaredUpThresholds.size()));
+    mThresholdCounts.push_back(static_cast<std::uint8_t>(switchDistances.size()));
+
+    [[maybe_unused]] float previous = 0.0f;
+    for (float distance : switchDistances)
+    {
+        assert(distance >= previous);
+        previous = distance;
+
+        float up = distance * (1.0f + mHysteresis);
+        float down = distance * (1.0f - mHysteresis);
+        mSquaredUpThresholds.push_back(up * up);
+        mSquaredDownThresholds.push_back(down * down);
+    }
+
+    mNodes.push_back(node);
+    mPositionsX.push_back(0.0f);
+    mPositionsY.push_back(0.0f);
+    mPositionsZ.push_back(0.0f);
+    mSquaredDistances.push_back(0.0f);
+    mLods.push_back(0);
+    return mNodes.size() - 1;
+}
+
+void LodSelector::clear()
+{
+    mNodes.clear();
+    mThresholdOffsets.clear();
+    mThresholdCounts.clear();
+    mSquaredUpThresholds.clear();
+    mSquaredDownThresholds.clear();
+    mPositionsX.clear();
+    mPositionsY.clear();
+    mPositionsZ.clear();
+    mSquaredDistances.clear();
+    mLods.clear();
+}
+
+std::span<const std::uint8_t> LodSelector::select(Node& camera)
+{
+    const size_t count = mNodes.size();
+    const glm::vec4& cameraPosition = camera.getGlobalMatrix()[3];
+
+    // Gather cached world translations so the distance loop runs over flat arrays
+    for (size_t i = 0; i < count; ++i)
+    {
+        const glm::vec4& position = mNodes[i]->getGlobalMatrix()[3];
+        mPositionsX[i] = position.x;
+        mPositionsY[i] = position.y;
+        mPositionsZ[i] = position.z;
+    }
+
+    const float cx = cameraPosition.x;
+    const float cy = cameraPosition.y;
+    const float cz = cameraPosition.z;
+    const float* xs = mPositionsX.data();
+    const float* ys = mPositionsY.data();
+    const float* zs = mPositionsZ.data();
+    float* distances = mSquaredDistances.data();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float dx = xs[i] - cx;
+        const float dy = ys[i] - cy;
+        const float dz = zs[i] - cz;
+        distances[i] = dx * dx + dy * dy + dz * dz;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float* up = mSquaredUpThresholds.data() + mThresholdOffsets[i];
+        const float* down = mSquaredDownThresholds.data() + mThresholdOffsets[i];
+        const std::uint8_t levels = mThresholdCounts[i];
+        const float distance = distances[i];
+
+        std::uint8_t lod = mLods[i];
+        while (lod < levels && distance > up[lod])
+        {
+            ++lod;
+        }
+        while (lod > 0 && distance < down[lod - 1])
+        {
+            --lod;
+        }
+        mLods[i] = lod;
+    }
+
+    return mLods;
+}
@@ -0,0 +1,125 @@
+//
+//  MotionHistory.cpp
+//  eSGraph
+//
+
+#include "MotionHistory.hpp"
+#include "Node.hpp"
+#include <cassert>
+
+using namespace eSGraph;
+
+MotionHistory::~MotionHistory()
+{
+    for (Node* node : mNodes)
+    {
+        if (node)
+        {
+            node->mMotionHistory = nullptr;
+        }
+    }
+}
+
+std::uint32_t MotionHistory::track(Node* node)
+{
+    assert(node != nullptr);
+    assert(node->mMotionHistory == nullptr);
+
+    const auto id = static_cast<std::uint32_t>(mNodes.size());
+    node->mMotionHistory = this;
+    node->mMotionIndex = id;
+
+    // Resolving the matrix now guarantees the next invalidation reaches markMoved
+    const glm::mat4& global = node->getGlobalMatrix();
+    mNodes.push_back(node);
+    mMatrices.push_back({global, global});
+    mMarked.push_back(0);
+    return id;
+}
+
+std::uint32_t MotionHistory::trackSubtree(Node& root)
+{
+    const auto first = static_cast<std::uint32_t>(mNodes.size());
+
+    std::vector<Node*> stack{&root};
+    while (!stack.empty())
+    {
+        Node* current = stack.back();
+        stack.pop_back();
+
+        track(current);
+
+        const auto& children = current->getChildren();
+        for (auto it = children.rbegin(); it != children.rend(); ++it)
+        {
+            stack.push_back(it->get());
+        }
+    }
+    return first;
+}
+
+void MotionHistory::untrack(Node* node)
+{
+    assert(node != nullptr && node->mMotionHistory == this);
+    forget(node->mMotionIndex);
+    node->mMotionHistory = nullptr;
+}
+
+Node* MotionHistory::getNode(std::uint32_t id) const noexcept
+{
+    return id < mNodes.size() ? mNodes[id] : nullptr;
+}
+
+void MotionHistory::markMoved(std::uint32_t id)
+{
+    if (mMarked[id])
+    {
+        return;
+    }
+    mMarked[id] = 1;
+    mMoved.push_back(id);
+}
+
+void MotionHistory::forget(std::uint32_t id) noexcept
+{
+    // Keep the id reserved so the remaining ids stay stable
+    mNodes[id] = nullptr;
+}
+
+void MotionHistory::advanceFrame()
+{
+    // Moved last frame but not this one: the node is at rest again
+    for (std::uint32_t id : mSettling)
+    {
+        if (!mMarked[id])
+        {
+            mMatrices[id].previous = mMatrices[id].current;
+        }
+    }
+    mSettling.clear();
+
+    for (std::uint32_t id : mMoved)
+    {
+        mMarked[id] = 0;
+        Node* node = mNodes[id];
+        if (!node)
+        {
+            continue;
+        }
+
+        MotionMatrices& matrices = mMatrices[id];
+        matrices.previous = matrices.current;
+        matrices.current = node->getGlobalMatrix();
+        mSettling.push_back(id);
+    }
+    mMoved.clear();
+}
+
+void MotionHistory::exportMatrices(std::span<const std::uint32_t> ids, std::span<MotionMatrices> out) const
+{
+    assert(ids.size() == out.size());
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        out[i] = mMatrices[ids[i]];
+    }
+}
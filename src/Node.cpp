@@ -6,11 +6,98 @@
 //
 
 #include "Node.hpp"
+#include "TransformRecorder.hpp"
+#include "MotionHistory.hpp"
 #include <vector>
 #include <cmath>
+#include <utility>
+#include <algorithm>
+#include <mutex>
 
 using namespace eSGraph;
 
+namespace {
+
+struct NodeSlot
+{
+    Node* node{nullptr};
+    std::uint32_t generation{1};
+};
+
+struct SlotTable
+{
+    std::mutex mutex;
+    // Slot 0 stays empty so that a zero index is the null handle
+    std::vector<NodeSlot> slots = std::vector<NodeSlot>(1);
+    std::vector<std::uint32_t> freeSlots;
+};
+
+// Never destroyed: nodes with static storage may release their slot during exit
+SlotTable& getSlotTable()
+{
+    static SlotTable* table = new SlotTable();
+    return *table;
+}
+
+Node* resolveLocked(const SlotTable& table, NodeHandle handle) noexcept
+{
+    if (handle.index == 0 || handle.index >= table.slots.size())
+    {
+        return nullptr;
+    }
+    const NodeSlot& slot = table.slots[handle.index];
+    return slot.generation == handle.generation ? slot.node : nullptr;
+}
+
+// Composes only when every link multiplies plainly by its parent
+bool composesLocally(const Node& node)
+{
+    return node.getInheritance() == TransformInheritance::ALL;
+}
+
+// S^-1 * R^T * T^-1 without a general 4x4 inverse
+glm::mat4 inverseLocalMatrix(const Node& node)
+{
+    const glm::vec3 inverseScale = 1.0f / node.getScale();
+    const glm::mat3 rotation = glm::mat3_cast(glm::conjugate(node.getRotation()));
+    glm::mat4 inverse(1.0f);
+    inverse[0] = glm::vec4(rotation[0] * inverseScale, 0.0f);
+    inverse[1] = glm::vec4(rotation[1] * inverseScale, 0.0f);
+    inverse[2] = glm::vec4(rotation[2] * inverseScale, 0.0f);
+    inverse[3] = glm::vec4(glm::mat3(inverse) * -node.getPosition(), 1.0f);
+    return inverse;
+}
+
+// Inverse of a world matrix without the general 4x4 path: invert the 3x3 block and
+// carry the translation through it
+glm::mat4 affineInverse(const glm::mat4& matrix)
+{
+    const glm::mat3 basis = glm::inverse(glm::mat3(matrix));
+    glm::mat4 inverse(basis);
+    inverse[3] = glm::vec4(basis * -glm::vec3(matrix[3]), 1.0f);
+    return inverse;
+}
+
+void decomposeMatrix(const glm::mat4& matrix, glm::vec3& position, glm::quat& rotation, glm::vec3& scale)
+{
+    position = glm::vec3(matrix[3]);
+    glm::mat3 basis(matrix);
+    scale = glm::vec3(glm::length(basis[0]), glm::length(basis[1]), glm::length(basis[2]));
+    if (glm::dot(glm::cross(basis[0], basis[1]), basis[2]) < 0.0f)
+    {
+        scale.x = -scale.x;
+    }
+    basis[0] /= scale.x;
+    basis[1] /= scale.y;
+    basis[2] /= scale.z;
+    rotation = glm::normalize(glm::quat_cast(basis));
+}
+
+}
+
+std::atomic<std::uint32_t> Node::sOriginEpoch{0};
+std::atomic<std::uint32_t> Node::sStructureEpoch{0};
+
 Node::Node() = default;
 
 Node::Node(std::string identifier)
@@ -18,6 +105,85 @@ Node::Node(std::string identifier)
 {
 }
 
+Node::~Node()
+{
+    if (!mHandle.isNull())
+    {
+        SlotTable& table = getSlotTable();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        NodeSlot& slot = table.slots[mHandle.index];
+        slot.node = nullptr;
+        ++slot.generation;
+        table.freeSlots.push_back(mHandle.index);
+    }
+    if (!mChildren.empty())
+    {
+        // Every node is emptied before it is released, so no destructor below recurses
+        std::vector<std::unique_ptr<Node>> pending = std::move(mChildren);
+        while (!pending.empty())
+        {
+            std::unique_ptr<Node> node = std::move(pending.back());
+            pending.pop_back();
+            for (auto& child : node->mChildren)
+            {
+                pending.push_back(std::move(child));
+            }
+            node->mChildren.clear();
+        }
+    }
+    if (mRecorder)
+    {
+        mRecorder->forget(mRecorderIndex);
+    }
+    if (mMotionHistory)
+    {
+        mMotionHistory->forget(mMotionIndex);
+    }
+}
+
+NodeHandle Node::getHandle() const
+{
+    if (mHandle.isNull())
+    {
+        SlotTable& table = getSlotTable();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        std::uint32_t index;
+        if (table.freeSlots.empty())
+        {
+            index = static_cast<std::uint32_t>(table.slots.size());
+            table.slots.emplace_back();
+        }
+        else
+        {
+            index = table.freeSlots.back();
+            table.freeSlots.pop_back();
+        }
+        NodeSlot& slot = table.slots[index];
+        slot.node = const_cast<Node*>(this);
+        mHandle = {index, slot.generation};
+    }
+    return mHandle;
+}
+
+Node* Node::resolve(NodeHandle handle) noexcept
+{
+    SlotTable& table = getSlotTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return resolveLocked(table, handle);
+}
+
+void Node::resolve(std::span<const NodeHandle> handles, std::span<Node*> nodes) noexcept
+{
+    assert(nodes.size() >= handles.size());
+
+    SlotTable& table = getSlotTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    for (size_t i = 0; i < handles.size(); ++i)
+    {
+        nodes[i] = resolveLocked(table, handles[i]);
+    }
+}
+
 void Node::setIdentifier(std::string_view identifier)
 {
     mIdentifier = identifier;
@@ -33,6 +199,41 @@ bool Node::isChildOf(std::string_view identifier) const noexcept
     return hasParent() && mParent->getIdentifier() == identifier;
 }
 
+bool Node::isDescendantOf(const Node* ancestor) const noexcept
+{
+    for (const Node* current = mParent; current != nullptr; current = current->mParent)
+    {
+        if (current == ancestor)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+Node* Node::findCommonAncestor(Node& other) noexcept
+{
+    Node* first = this;
+    Node* second = &other;
+    size_t firstDepth = first->getDepth();
+    size_t secondDepth = second->getDepth();
+
+    for (; firstDepth > secondDepth; --firstDepth)
+    {
+        first = first->mParent;
+    }
+    for (; secondDepth > firstDepth; --secondDepth)
+    {
+        second = second->mParent;
+    }
+    while (first != second)
+    {
+        first = first->mParent;
+        second = second->mParent;
+    }
+    return first;
+}
+
 bool Node::hasChild(const Node* child) const noexcept
 {
     return child != nullptr && child->getParent() == this;
@@ -56,7 +257,38 @@ void Node::addChild(std::unique_ptr<Node> child)
 
     child->mParent = this;
     child->setGlobalMatrixDirty();
+    const std::uint64_t childLayers = child->mSubtreeLayerMask;
+    bumpStructureEpoch();
+    child->mChildIndex = static_cast<std::uint32_t>(mChildren.size());
     mChildren.push_back(std::move(child));
+    if ((mSubtreeLayerMask & childLayers) != childLayers)
+    {
+        refreshSubtreeLayerMask();
+    }
+}
+
+void Node::addChildren(std::vector<std::unique_ptr<Node>>&& children)
+{
+    mChildren.reserve(mChildren.size() + children.size());
+
+    std::uint64_t childLayers = 0;
+    for (auto& child : children)
+    {
+        assert(child && !child->hasParent());
+        child->mParent = this;
+        // Freshly built nodes are already dirty, so this is an early exit for them
+        child->setGlobalMatrixDirty();
+        childLayers |= child->mSubtreeLayerMask;
+        child->mChildIndex = static_cast<std::uint32_t>(mChildren.size());
+        mChildren.push_back(std::move(child));
+    }
+    children.clear();
+
+    bumpStructureEpoch();
+    if ((mSubtreeLayerMask & childLayers) != childLayers)
+    {
+        refreshSubtreeLayerMask();
+    }
 }
 
 std::unique_ptr<Node> Node::removeChild(std::string_view identifier)
@@ -81,14 +313,31 @@ std::unique_ptr<Node> Node::removeChild(Node* child)
         child->mParent = nullptr;
         child->setGlobalMatrixDirty();
 
-        for (auto it = mChildren.begin(); it != mChildren.end(); ++it)
+        const std::uint32_t index = child->mChildIndex;
+        assert(mChildren[index].get() == child);
+        returnElement = std::move(mChildren[index]);
+        if (mUnorderedChildren)
         {
-            if (it->get() == child)
+            if (index + 1 != mChildren.size())
             {
-                returnElement = std::move(*it);
-                mChildren.erase(it);
-                break;
+                mChildren[index] = std::move(mChildren.back());
+                mChildren[index]->mChildIndex = index;
             }
+            mChildren.pop_back();
+        }
+        else
+        {
+            mChildren.erase(mChildren.begin() + index);
+            for (size_t i = index; i < mChildren.size(); ++i)
+            {
+                mChildren[i]->mChildIndex = static_cast<std::uint32_t>(i);
+            }
+        }
+        child->mChildIndex = 0;
+        bumpStructureEpoch();
+        if (child->mSubtreeLayerMask != 0)
+        {
+            refreshSubtreeLayerMask();
         }
     }
     return returnElement;
@@ -106,14 +355,183 @@ std::unique_ptr<Node> Node::detach()
     return mParent->removeChild(this);
 }
 
+void Node::reparent(std::span<Node* const> nodes, Node* newParent, KeepWorld keepWorld)
+{
+    assert(newParent != nullptr);
+
+    // Resolve every world pose before the hierarchy changes, so nodes nested inside
+    // other moved subtrees keep theirs too
+    std::vector<Node*> moved;
+    std::vector<glm::mat4> worlds;
+    moved.reserve(nodes.size());
+    if (keepWorld == KeepWorld::YES)
+    {
+        worlds.reserve(nodes.size());
+    }
+    // A node listed more than once is moved once, at its first position
+    std::vector<std::pair<Node*, size_t>> firstSeen;
+    firstSeen.reserve(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        firstSeen.emplace_back(nodes[i], i);
+    }
+    std::sort(firstSeen.begin(), firstSeen.end());
+    firstSeen.erase(std::unique(firstSeen.begin(), firstSeen.end(),
+                                [](const auto& a, const auto& b) { return a.first == b.first; }),
+                    firstSeen.end());
+    std::vector<size_t> order;
+    order.reserve(firstSeen.size());
+    for (const auto& entry : firstSeen)
+    {
+        order.push_back(entry.second);
+    }
+    std::sort(order.begin(), order.end());
+
+    const glm::dvec3& newOrigin = newParent->getRoot()->mOrigin;
+    for (size_t index : order)
+    {
+        Node* node = nodes[index];
+        assert(node && node->hasParent());
+        assert(node != newParent && !newParent->isDescendantOf(node));
+        if (node->mParent == newParent)
+        {
+            continue;
+        }
+        moved.push_back(node);
+        if (keepWorld == KeepWorld::YES)
+        {
+            glm::mat4 world = node->getGlobalMatrix();
+            // World matrices are relative to each hierarchy's floating origin
+            world[3] += glm::vec4(glm::vec3(node->getRoot()->mOrigin - newOrigin), 0.0f);
+            worlds.push_back(world);
+        }
+    }
+    if (moved.empty())
+    {
+        return;
+    }
+
+    // One compaction per old parent instead of a linear search per node
+    std::vector<std::pair<Node*, size_t>> sortedMoved;
+    sortedMoved.reserve(moved.size());
+    for (size_t i = 0; i < moved.size(); ++i)
+    {
+        sortedMoved.emplace_back(moved[i], i);
+    }
+    std::sort(sortedMoved.begin(), sortedMoved.end());
+    std::vector<Node*> oldParents;
+    oldParents.reserve(moved.size());
+    for (Node* node : moved)
+    {
+        oldParents.push_back(node->mParent);
+    }
+    std::sort(oldParents.begin(), oldParents.end());
+    oldParents.erase(std::unique(oldParents.begin(), oldParents.end()), oldParents.end());
+
+    std::vector<std::unique_ptr<Node>> owned(moved.size());
+    for (Node* oldParent : oldParents)
+    {
+        auto kept = oldParent->mChildren.begin();
+        for (auto& child : oldParent->mChildren)
+        {
+            const auto found = std::lower_bound(sortedMoved.begin(), sortedMoved.end(),
+                                                std::make_pair(child.get(), size_t{0}));
+            if (found != sortedMoved.end() && found->first == child.get())
+            {
+                owned[found->second] = std::move(child);
+            }
+            else
+            {
+                child->mChildIndex = static_cast<std::uint32_t>(kept - oldParent->mChildren.begin());
+                *kept++ = std::move(child);
+            }
+        }
+        oldParent->mChildren.erase(kept, oldParent->mChildren.end());
+        oldParent->refreshSubtreeLayerMask();
+    }
+
+    newParent->mChildren.reserve(newParent->mChildren.size() + owned.size());
+    std::uint64_t movedLayers = 0;
+    for (auto& child : owned)
+    {
+        child->mParent = newParent;
+        movedLayers |= child->mSubtreeLayerMask;
+        child->mChildIndex = static_cast<std::uint32_t>(newParent->mChildren.size());
+        newParent->mChildren.push_back(std::move(child));
+    }
+    bumpStructureEpoch();
+    if ((newParent->mSubtreeLayerMask & movedLayers) != movedLayers)
+    {
+        newParent->refreshSubtreeLayerMask();
+    }
+
+    if (keepWorld == KeepWorld::YES)
+    {
+        const glm::mat4 parentInverse = affineInverse(newParent->getGlobalMatrix());
+        for (size_t i = 0; i < moved.size(); ++i)
+        {
+            Node* node = moved[i];
+            const glm::mat4 inverse = node->mInheritance == TransformInheritance::ALL
+                ? parentInverse
+                : affineInverse(node->getInheritedParentMatrix());
+            decomposeMatrix(inverse * worlds[i], node->mPosition, node->mRotation, node->mScale);
+        }
+    }
+
+    // A single dirty pass per moved subtree covers both the new parent and new locals
+    for (Node* node : moved)
+    {
+        if (keepWorld == KeepWorld::YES)
+        {
+            node->setMatrixDirty();
+        }
+        else
+        {
+            node->setGlobalMatrixDirty();
+        }
+    }
+}
+
 std::vector<std::unique_ptr<Node>> Node::removeAllChildren()
 {
     for (auto& child : mChildren)
     {
         child->mParent = nullptr;
+        child->mChildIndex = 0;
         child->setGlobalMatrixDirty();
     }
-    return std::move(mChildren);
+    bumpStructureEpoch();
+    std::vector<std::unique_ptr<Node>> children = std::move(mChildren);
+    mChildren.clear();
+    if (mSubtreeLayerMask != mLayerMask)
+    {
+        refreshSubtreeLayerMask();
+    }
+    return children;
+}
+
+void Node::setLayerMask(std::uint64_t layers)
+{
+    mLayerMask = layers;
+    refreshSubtreeLayerMask();
+}
+
+void Node::refreshSubtreeLayerMask()
+{
+    // Recompute up the ancestor chain until a subtree mask comes out unchanged
+    for (Node* node = this; node != nullptr; node = node->mParent)
+    {
+        std::uint64_t layers = node->mLayerMask;
+        for (const auto& child : node->mChildren)
+        {
+            layers |= child->mSubtreeLayerMask;
+        }
+        if (layers == node->mSubtreeLayerMask)
+        {
+            break;
+        }
+        node->mSubtreeLayerMask = layers;
+    }
 }
 
 const std::vector<std::unique_ptr<Node>>& Node::getChildren() const noexcept
@@ -177,19 +595,8 @@ Node* Node::getNextSibling() const noexcept
     }
 
     const auto& siblings = mParent->mChildren;
-    for (auto it = siblings.begin(); it != siblings.end(); ++it)
-    {
-        if (it->get() == this)
-        {
-            ++it;
-            if (it != siblings.end())
-            {
-                return it->get();
-            }
-            return nullptr;
-        }
-    }
-    return nullptr;
+    const size_t next = mChildIndex + size_t{1};
+    return next < siblings.size() ? siblings[next].get() : nullptr;
 }
 
 Node* Node::getPreviousSibling() const noexcept
@@ -199,26 +606,18 @@ Node* Node::getPreviousSibling() const noexcept
         return nullptr;
     }
 
-    const auto& siblings = mParent->mChildren;
-    Node* previous = nullptr;
-    for (const auto& sibling : siblings)
-    {
-        if (sibling.get() == this)
-        {
-            return previous;
-        }
-        previous = sibling.get();
-    }
-    return nullptr;
+    return mChildIndex > 0 ? mParent->mChildren[mChildIndex - 1].get() : nullptr;
 }
 
 glm::vec3 Node::getPosition(Coordinates coordinates) const
 {
     switch (coordinates) {
         case Coordinates::WORLD:
+            if (mGlobalOverride && isOriginCurrent())
+                return glm::vec3(mGlobalMatrix[3]);
             if (hasParent())
-                return mParent->getGlobalMatrix() * glm::vec4(mPosition, 1.0);
-            [[fallthrough]];
+                return getInheritedParentMatrix() * glm::vec4(mPosition, 1.0);
+            return glm::vec3(glm::dvec3(mPosition) - mOrigin);
         case Coordinates::PARENT:
         case Coordinates::LOCAL:
         default:
@@ -232,10 +631,13 @@ void Node::setPosition(const glm::vec3& position, Coordinates coordinates)
         case Coordinates::WORLD:
             if (hasParent())
             {
-                mPosition = glm::inverse(mParent->getGlobalMatrix()) * glm::vec4(position, 1.0f);
-                break;
+                mPosition = glm::inverse(getInheritedParentMatrix()) * glm::vec4(position, 1.0f);
             }
-            [[fallthrough]];
+            else
+            {
+                mPosition = glm::vec3(glm::dvec3(position) + mOrigin);
+            }
+            break;
         case Coordinates::PARENT:
         case Coordinates::LOCAL:
         default:
@@ -265,9 +667,9 @@ glm::quat Node::getRotation(Coordinates coordinates) const
 {
     switch (coordinates) {
         case Coordinates::WORLD:
-            if (hasParent())
+            if (hasParent() || mGlobalOverride)
             {
-                return mParent->getRotation(Coordinates::WORLD) * mRotation;
+                return getWorldRotationCached();
             }
             [[fallthrough]];
         case Coordinates::PARENT:
@@ -293,7 +695,7 @@ void Node::setRotation(const glm::quat& rotation, Coordinates coordinates)
         case Coordinates::WORLD:
             if (hasParent())
             {
-                mRotation = glm::conjugate(mParent->getRotation(Coordinates::WORLD)) * glm::normalize(rotation);
+                mRotation = glm::conjugate(getInheritedParentRotation()) * glm::normalize(rotation);
                 break;
             }
             [[fallthrough]];
@@ -314,9 +716,40 @@ void Node::setRotation(const glm::vec3& eulerAngles, Coordinates coordinates)
 void Node::setMatrixDirty()
 {
     mMatrixDirty = true;
+    if (mRecorder)
+    {
+        mRecorder->markChanged(mRecorderIndex);
+    }
     setGlobalMatrixDirty();
 }
 
+void Node::setLocalTransforms(std::span<Node* const> nodes,
+                              std::span<const glm::vec3> positions,
+                              std::span<const glm::quat> rotations,
+                              std::span<const glm::vec3> scales)
+{
+    assert(positions.empty() || positions.size() == nodes.size());
+    assert(rotations.empty() || rotations.size() == nodes.size());
+    assert(scales.empty() || scales.size() == nodes.size());
+
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        Node* node = nodes[i];
+        if (!positions.empty())
+            node->mPosition = positions[i];
+        if (!rotations.empty())
+            node->mRotation = rotations[i];
+        if (!scales.empty())
+            node->mScale = scales[i];
+    }
+
+    // Parents listed before their children turn the remaining walks into early exits
+    for (Node* node : nodes)
+    {
+        node->setMatrixDirty();
+    }
+}
+
 void Node::setGlobalMatrixDirty()
 {
     thread_local std::vector<Node*> stack;
@@ -329,11 +762,19 @@ void Node::setGlobalMatrixDirty()
         Node* current = stack.back();
         stack.pop_back();
 
-        if (current->mGlobalMatrixDirty)
-            continue;  // Skip already-dirty subtrees
+        // World rotations are cached independently of world matrices, so a node is
+        // only fully dirty (and its subtree with it) once both caches are
+        if ((current->mGlobalMatrixDirty && current->mWorldRotationDirty) || current->mStatic)
+            continue;  // Skip already-dirty and frozen subtrees
 
         current->mGlobalMatrixDirty = true;
         current->mWorldRotationDirty = true;
+        current->mGlobalOverride = false;
+        current->mPreciseDirty = true;
+        if (current->mMotionHistory)
+        {
+            current->mMotionHistory->markMoved(current->mMotionIndex);
+        }
 
         for (auto& child : current->mChildren)
         {
@@ -352,13 +793,221 @@ const glm::quat& Node::getWorldRotationCached() const
         }
         else
         {
-            mWorldRotation = mParent->getWorldRotationCached() * mRotation;
+            mWorldRotation = inherits(TransformInheritance::ROTATION)
+                ? mParent->getWorldRotationCached() * mRotation
+                : mRotation;
         }
         mWorldRotationDirty = false;
     }
     return mWorldRotation;
 }
 
+void Node::rebaseOrigin(std::span<Node* const> roots, const glm::dvec3& delta)
+{
+    for (Node* root : roots)
+    {
+        assert(root && !root->hasParent());
+        root->mOrigin += delta;
+    }
+    sOriginEpoch.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Node::setOrigin(const glm::dvec3& origin)
+{
+    assert(!hasParent());
+    mOrigin = origin;
+    sOriginEpoch.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Node::syncOrigin()
+{
+    const std::uint32_t epoch = sOriginEpoch.load(std::memory_order_relaxed);
+    if (mOriginEpoch == epoch)
+    {
+        return;
+    }
+
+    // Stale ancestors are brought up to date top-down, so each node compares against
+    // a parent that already matches the root. Hierarchies whose origin did not change
+    // keep their cached matrices.
+    thread_local std::vector<Node*> path;
+    path.clear();
+    for (Node* node = this; node != nullptr && node->mOriginEpoch != epoch; node = node->mParent)
+    {
+        path.push_back(node);
+    }
+
+    for (auto it = path.rbegin(); it != path.rend(); ++it)
+    {
+        Node* node = *it;
+        node->mOriginEpoch = epoch;
+        const glm::dvec3 origin = node->hasParent() ? node->mParent->mCachedOrigin : node->mOrigin;
+        if (node->mCachedOrigin == origin)
+        {
+            continue;
+        }
+
+        if (node->mStatic && !node->mGlobalMatrixDirty)
+        {
+            // Frozen matrices keep what was baked and only move with the origin
+            node->mGlobalMatrix[3] += glm::vec4(glm::vec3(node->mCachedOrigin - origin), 0.0f);
+            ++node->mGlobalMatrixVersion;
+        }
+        else
+        {
+            // An override was expressed relative to the old origin, so it is dropped
+            // like any other invalidation
+            node->mGlobalMatrixDirty = true;
+            if (node->mGlobalOverride)
+            {
+                node->mGlobalOverride = false;
+                node->mWorldRotationDirty = true;
+                node->mPreciseDirty = true;
+            }
+        }
+        node->mCachedOrigin = origin;
+    }
+}
+
+const glm::dvec3& Node::getPreciseWorldPosition()
+{
+    if (mPreciseDirty && !mStatic)
+    {
+        // Cleans the world matrix as well, so the next dirty walk reaches this node
+        (void)getGlobalMatrix();
+        if (mGlobalOverride)
+        {
+            // Overrides are stored relative to the origin like every world matrix
+            mPreciseWorldPosition = glm::dvec3(glm::vec3(mGlobalMatrix[3])) + mCachedOrigin;
+        }
+        else if (!hasParent())
+        {
+            mPreciseWorldPosition = glm::dvec3(mPosition);
+        }
+        else
+        {
+            // The float basis only scales the local offset; the large sum stays in double
+            const glm::dmat3 basis{glm::mat3(getInheritedParentMatrix())};
+            const glm::dvec3 anchor = inherits(TransformInheritance::TRANSLATION)
+                ? mParent->getPreciseWorldPosition()
+                : glm::dvec3(0.0);
+            mPreciseWorldPosition = anchor + basis * glm::dvec3(mPosition);
+        }
+        mPreciseDirty = false;
+    }
+    return mPreciseWorldPosition;
+}
+
+void Node::exportCameraRelativeMatrices(std::span<Node* const> nodes,
+                                        const glm::dvec3& cameraPosition,
+                                        std::span<glm::mat4> matrices)
+{
+    assert(matrices.size() >= nodes.size());
+
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        Node* node = nodes[i];
+        glm::mat4& matrix = matrices[i];
+        matrix = node->getGlobalMatrix();
+        matrix[3] = glm::vec4(glm::vec3(node->getPreciseWorldPosition() - cameraPosition), 1.0f);
+    }
+}
+
+void Node::setInheritance(TransformInheritance inheritance)
+{
+    mInheritance = inheritance;
+    setGlobalMatrixDirty();
+}
+
+glm::mat4 Node::getInheritedParentMatrix() const
+{
+    if (!hasParent())
+    {
+        // Root world positions are relative to the floating origin
+        glm::mat4 inherited = glm::identity<glm::mat4>();
+        inherited[3] = glm::vec4(glm::vec3(-mOrigin), 1.0f);
+        return inherited;
+    }
+
+    const glm::mat4& parentMatrix = mParent->getGlobalMatrix();
+    if (mInheritance == TransformInheritance::ALL)
+    {
+        return parentMatrix;
+    }
+
+    glm::mat4 inherited = glm::identity<glm::mat4>();
+    if (inherits(TransformInheritance::ROTATION) || inherits(TransformInheritance::SCALE))
+    {
+        const glm::mat3 basis = inherits(TransformInheritance::ROTATION)
+            ? glm::mat3_cast(mParent->getWorldRotationCached())
+            : glm::mat3(1.0f);
+        const glm::vec3 scale = inherits(TransformInheritance::SCALE)
+            ? glm::vec3(glm::length(glm::vec3(parentMatrix[0])),
+                        glm::length(glm::vec3(parentMatrix[1])),
+                        glm::length(glm::vec3(parentMatrix[2])))
+            : glm::vec3(1.0f);
+        inherited[0] = glm::vec4(basis[0] * scale.x, 0.0f);
+        inherited[1] = glm::vec4(basis[1] * scale.y, 0.0f);
+        inherited[2] = glm::vec4(basis[2] * scale.z, 0.0f);
+    }
+    if (inherits(TransformInheritance::TRANSLATION))
+    {
+        inherited[3] = parentMatrix[3];
+    }
+    else
+    {
+        // Still placed relative to the floating origin of the hierarchy
+        inherited[3] = glm::vec4(glm::vec3(-getRoot()->mOrigin), 1.0f);
+    }
+    return inherited;
+}
+
+glm::mat4 Node::applyInheritedParentMatrix(const glm::mat4& local) const
+{
+    if (hasParent())
+    {
+        return getInheritedParentMatrix() * local;
+    }
+
+    // Subtract in double so large root positions stay precise near the origin
+    glm::mat4 world = local;
+    world[3] = glm::vec4(glm::vec3(glm::dvec3(glm::vec3(local[3])) - mOrigin), 1.0f);
+    return world;
+}
+
+glm::quat Node::getInheritedParentRotation() const
+{
+    if (!hasParent() || !inherits(TransformInheritance::ROTATION))
+    {
+        return glm::identity<glm::quat>();
+    }
+    return mParent->getWorldRotationCached();
+}
+
+void Node::overrideGlobalTransform(const glm::mat4& globalMatrix, const glm::quat& worldRotation)
+{
+    mGlobalMatrix = globalMatrix;
+    mWorldRotation = worldRotation;
+    mGlobalMatrixDirty = false;
+    mWorldRotationDirty = false;
+    mGlobalOverride = true;
+    mPreciseDirty = true;
+    // Callers build the override from the parent's world matrix, so the parent's
+    // origin is current
+    mOriginEpoch = sOriginEpoch.load(std::memory_order_relaxed);
+    mCachedOrigin = hasParent() ? mParent->mCachedOrigin : mOrigin;
+    ++mGlobalMatrixVersion;
+    if (mMotionHistory)
+    {
+        mMotionHistory->markMoved(mMotionIndex);
+    }
+
+    for (auto& child : mChildren)
+    {
+        child->setGlobalMatrixDirty();
+    }
+}
+
 const glm::mat4& Node::getMatrix()
 {
     if (mMatrixDirty)
@@ -373,18 +1022,72 @@ const glm::mat4& Node::getMatrix()
 
 const glm::mat4& Node::getGlobalMatrix()
 {
+    syncOrigin();
+
     if (mGlobalMatrixDirty)
     {
         if (!hasParent())
-            mGlobalMatrix = getMatrix();
-        else
+            mGlobalMatrix = applyInheritedParentMatrix(getMatrix());
+        else if (mInheritance == TransformInheritance::ALL)
             mGlobalMatrix = mParent->getGlobalMatrix() * getMatrix();
+        else
+            mGlobalMatrix = getInheritedParentMatrix() * getMatrix();
 
+        mCachedOrigin = hasParent() ? mParent->mCachedOrigin : mOrigin;
         mGlobalMatrixDirty = false;
+        ++mGlobalMatrixVersion;
     }
     return mGlobalMatrix;
 }
 
+glm::mat4 Node::getTransformRelativeTo(Node& target)
+{
+    Node* ancestor = findCommonAncestor(target);
+    if (ancestor != nullptr)
+    {
+        bool local = true;
+        glm::mat4 sourceChain(1.0f);
+        // Overridden and frozen world matrices no longer follow the local chain
+        for (Node* node = this; local && node != ancestor; node = node->mParent)
+        {
+            local = composesLocally(*node) && !node->mGlobalOverride && !node->mStatic;
+            sourceChain = node->getMatrix() * sourceChain;
+        }
+
+        glm::mat4 targetInverse(1.0f);
+        for (Node* node = &target; local && node != ancestor; node = node->mParent)
+        {
+            local = composesLocally(*node) && !node->mGlobalOverride && !node->mStatic;
+            targetInverse = targetInverse * inverseLocalMatrix(*node);
+        }
+
+        if (local)
+        {
+            return targetInverse * sourceChain;
+        }
+    }
+    return glm::inverse(target.getGlobalMatrix()) * getGlobalMatrix();
+}
+
+const glm::mat4& Node::getTransformRelativeTo(Node& target, RelativeTransformCache& cache)
+{
+    // Resolving both world matrices is free when they are clean, and leaves the nodes
+    // where the next dirty walk will bump their versions
+    (void)getGlobalMatrix();
+    (void)target.getGlobalMatrix();
+
+    if (cache.source != this || cache.target != &target ||
+        cache.sourceVersion != mGlobalMatrixVersion || cache.targetVersion != target.mGlobalMatrixVersion)
+    {
+        cache.matrix = getTransformRelativeTo(target);
+        cache.source = this;
+        cache.target = &target;
+        cache.sourceVersion = mGlobalMatrixVersion;
+        cache.targetVersion = target.mGlobalMatrixVersion;
+    }
+    return cache.matrix;
+}
+
 void Node::translate(const glm::vec3& translationVector, Coordinates coordinates)
 {
     switch (coordinates) {
@@ -520,18 +1223,154 @@ void Node::lookAt(const glm::vec3& target, const glm::vec3& up)
 
 std::unique_ptr<Node> Node::clone() const
 {
-    auto cloned = std::make_unique<Node>(mIdentifier);
+    std::vector<const Node*> nodes;
+    std::vector<std::uint32_t> parents;
+    collectSubtree(nodes, parents);
+    return cloneCollected(nodes, parents);
+}
 
-    cloned->mPosition = mPosition;
-    cloned->mRotation = mRotation;
-    cloned->mScale = mScale;
-    cloned->mMatrixDirty = true;
-    cloned->mGlobalMatrixDirty = true;
+std::vector<std::unique_ptr<Node>> Node::clone(size_t count) const
+{
+    std::vector<const Node*> nodes;
+    std::vector<std::uint32_t> parents;
+    collectSubtree(nodes, parents);
 
-    for (const auto& child : mChildren)
+    std::vector<std::unique_ptr<Node>> clones;
+    clones.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        clones.push_back(cloneCollected(nodes, parents));
+    }
+    return clones;
+}
+
+void Node::collectSubtree(std::vector<const Node*>& nodes, std::vector<std::uint32_t>& parents) const
+{
+    std::vector<const Node*> stack;
+    stack.push_back(this);
+
+    size_t count = 0;
+    while (!stack.empty())
     {
-        cloned->addChild(child->clone());
+        const Node* current = stack.back();
+        stack.pop_back();
+        ++count;
+        for (const auto& child : current->mChildren)
+        {
+            stack.push_back(child.get());
+        }
     }
 
-    return cloned;
+    nodes.clear();
+    parents.clear();
+    nodes.reserve(count);
+    parents.reserve(count);
+
+    // Pre-order, so every parent index is smaller than its children's
+    std::vector<std::pair<const Node*, std::uint32_t>> pending;
+    pending.emplace_back(this, 0);
+    while (!pending.empty())
+    {
+        auto [current, parent] = pending.back();
+        pending.pop_back();
+
+        const auto index = static_cast<std::uint32_t>(nodes.size());
+        nodes.push_back(current);
+        parents.push_back(parent);
+
+        for (auto it = current->mChildren.rbegin(); it != current->mChildren.rend(); ++it)
+        {
+            pending.emplace_back(it->get(), index);
+        }
+    }
+}
+
+std::unique_ptr<Node> Node::cloneCollected(const std::vector<const Node*>& nodes,
+                                           const std::vector<std::uint32_t>& parents)
+{
+    std::vector<Node*> clones(nodes.size(), nullptr);
+    std::unique_ptr<Node> root;
+
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        const Node* source = nodes[i];
+        auto cloned = std::make_unique<Node>(source->mIdentifier);
+
+        // Local matrix only depends on the node's own TRS, so a clean cache stays valid.
+        // New nodes start with dirty global state, so no propagation walk is needed.
+        cloned->mPosition = source->mPosition;
+        cloned->mRotation = source->mRotation;
+        cloned->mScale = source->mScale;
+        cloned->mInheritance = source->mInheritance;
+        cloned->mLayerMask = source->mLayerMask;
+        cloned->mUnorderedChildren = source->mUnorderedChildren;
+        cloned->mSubtreeLayerMask = source->mSubtreeLayerMask;
+        cloned->mMatrix = source->mMatrix;
+        cloned->mMatrixDirty = source->mMatrixDirty;
+        cloned->mChildren.reserve(source->mChildren.size());
+        clones[i] = cloned.get();
+
+        if (i == 0)
+        {
+            root = std::move(cloned);
+        }
+        else
+        {
+            Node* parent = clones[parents[i]];
+            cloned->mParent = parent;
+            cloned->mChildIndex = static_cast<std::uint32_t>(parent->mChildren.size());
+            parent->mChildren.push_back(std::move(cloned));
+        }
+    }
+
+    return root;
+}
+
+void Node::freeze(std::vector<glm::mat4>* bakedMatrices)
+{
+    std::vector<Node*> stack;
+    stack.push_back(this);
+
+    while (!stack.empty())
+    {
+        Node* current = stack.back();
+        stack.pop_back();
+
+        const glm::mat4& globalMatrix = current->getGlobalMatrix();
+        (void)current->getWorldRotationCached();
+        // Baked alongside the matrix; frozen nodes return it as is
+        (void)current->getPreciseWorldPosition();
+        current->mStatic = true;
+
+        if (bakedMatrices)
+        {
+            bakedMatrices->push_back(globalMatrix);
+        }
+
+        for (auto it = current->mChildren.rbegin(); it != current->mChildren.rend(); ++it)
+        {
+            stack.push_back(it->get());
+        }
+    }
+}
+
+void Node::unfreeze()
+{
+    std::vector<Node*> stack;
+    stack.push_back(this);
+
+    while (!stack.empty())
+    {
+        Node* current = stack.back();
+        stack.pop_back();
+
+        current->mStatic = false;
+        for (auto& child : current->mChildren)
+        {
+            stack.push_back(child.get());
+        }
+    }
+
+    // Re-bake lazily from the current local transforms
+    setGlobalMatrixDirty();
 }
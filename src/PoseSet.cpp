@@ -0,0 +1,175 @@
+//
+//  PoseSet.cpp
+//  eSGraph
+//
+
+#include "PoseSet.hpp"
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+using namespace eSGraph;
+
+namespace {
+
+template<typename T>
+void relayout(std::vector<T>& values, size_t joints, size_t size, size_t oldCapacity, size_t newCapacity)
+{
+    std::vector<T> resized(joints * newCapacity);
+    for (size_t joint = 0; joint < joints; ++joint)
+    {
+        std::copy_n(values.begin() + static_cast<std::ptrdiff_t>(joint * oldCapacity), size,
+                    resized.begin() + static_cast<std::ptrdiff_t>(joint * newCapacity));
+    }
+    values = std::move(resized);
+}
+
+}
+
+PoseSet::PoseSet(std::shared_ptr<const Prototype> topology)
+    : mTopology{std::move(topology)}
+{
+    assert(mTopology != nullptr);
+}
+
+void PoseSet::reserve(size_t capacity)
+{
+    if (capacity <= mCapacity)
+    {
+        return;
+    }
+
+    const size_t joints = getJointCount();
+    relayout(mPositions, joints, mSize, mCapacity, capacity);
+    relayout(mRotations, joints, mSize, mCapacity, capacity);
+    relayout(mScales, joints, mSize, mCapacity, capacity);
+    relayout(mGlobalMatrices, joints, mSize, mCapacity, capacity);
+    mCapacity = capacity;
+}
+
+size_t PoseSet::spawn()
+{
+    if (mSize == mCapacity)
+    {
+        reserve(std::max<size_t>(mCapacity * 2, 16));
+    }
+
+    const size_t instance = mSize++;
+    for (size_t joint = 0; joint < getJointCount(); ++joint)
+    {
+        const size_t index = slot(instance, joint);
+        mPositions[index] = mTopology->getPosition(joint);
+        mRotations[index] = mTopology->getRotation(joint);
+        mScales[index] = mTopology->getScale(joint);
+    }
+    mDirty = true;
+    return instance;
+}
+
+void PoseSet::despawn(size_t instance)
+{
+    assert(instance < mSize);
+
+    const size_t last = mSize - 1;
+    if (instance != last)
+    {
+        for (size_t joint = 0; joint < getJointCount(); ++joint)
+        {
+            mPositions[slot(instance, joint)] = mPositions[slot(last, joint)];
+            mRotations[slot(instance, joint)] = mRotations[slot(last, joint)];
+            mScales[slot(instance, joint)] = mScales[slot(last, joint)];
+            mGlobalMatrices[slot(instance, joint)] = mGlobalMatrices[slot(last, joint)];
+        }
+    }
+    --mSize;
+}
+
+void PoseSet::clear() noexcept
+{
+    mSize = 0;
+}
+
+void PoseSet::setPosition(size_t instance, size_t joint, const glm::vec3& position)
+{
+    mPositions[slot(instance, joint)] = position;
+    mDirty = true;
+}
+
+void PoseSet::setRotation(size_t instance, size_t joint, const glm::quat& rotation)
+{
+    mRotations[slot(instance, joint)] = glm::normalize(rotation);
+    mDirty = true;
+}
+
+void PoseSet::setScale(size_t instance, size_t joint, const glm::vec3& scale)
+{
+    mScales[slot(instance, joint)] = scale;
+    mDirty = true;
+}
+
+void PoseSet::setPositions(size_t joint, std::span<const glm::vec3> positions)
+{
+    assert(positions.size() == mSize);
+    std::copy(positions.begin(), positions.end(), mPositions.begin() + static_cast<std::ptrdiff_t>(joint * mCapacity));
+    mDirty = true;
+}
+
+void PoseSet::setRotations(size_t joint, std::span<const glm::quat> rotations)
+{
+    assert(rotations.size() == mSize);
+    std::copy(rotations.begin(), rotations.end(), mRotations.begin() + static_cast<std::ptrdiff_t>(joint * mCapacity));
+    mDirty = true;
+}
+
+void PoseSet::setScales(size_t joint, std::span<const glm::vec3> scales)
+{
+    assert(scales.size() == mSize);
+    std::copy(scales.begin(), scales.end(), mScales.begin() + static_cast<std::ptrdiff_t>(joint * mCapacity));
+    mDirty = true;
+}
+
+void PoseSet::update()
+{
+    // Prototype order puts parents before children, so one pass over the joints suffices
+    const std::span<const std::uint32_t> parents = mTopology->getParentIndices();
+    for (size_t joint = 0; joint < parents.size(); ++joint)
+    {
+        const glm::vec3* positions = mPositions.data() + joint * mCapacity;
+        const glm::quat* rotations = mRotations.data() + joint * mCapacity;
+        const glm::vec3* scales = mScales.data() + joint * mCapacity;
+        glm::mat4* globals = mGlobalMatrices.data() + joint * mCapacity;
+        const glm::mat4* parentGlobals = parents[joint] == Prototype::NO_PARENT
+            ? nullptr
+            : mGlobalMatrices.data() + parents[joint] * mCapacity;
+
+        for (size_t instance = 0; instance < mSize; ++instance)
+        {
+            const glm::mat3 basis = glm::mat3_cast(rotations[instance]);
+            const glm::mat4 local(glm::vec4(basis[0] * scales[instance].x, 0.0f),
+                                  glm::vec4(basis[1] * scales[instance].y, 0.0f),
+                                  glm::vec4(basis[2] * scales[instance].z, 0.0f),
+                                  glm::vec4(positions[instance], 1.0f));
+            globals[instance] = parentGlobals ? parentGlobals[instance] * local : local;
+        }
+    }
+    mDirty = false;
+}
+
+const glm::mat4& PoseSet::getGlobalMatrix(size_t instance, size_t joint)
+{
+    assert(instance < mSize);
+    if (mDirty)
+    {
+        update();
+    }
+    return mGlobalMatrices[slot(instance, joint)];
+}
+
+std::span<const glm::mat4> PoseSet::getGlobalMatrices(size_t joint)
+{
+    if (mDirty)
+    {
+        update();
+    }
+    return {mGlobalMatrices.data() + joint * mCapacity, mSize};
+}
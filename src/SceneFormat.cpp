@@ -0,0 +1,385 @@
+//
+//  SceneFormat.cpp
+//  eSGraph
+//
+
+#include "SceneFormat.hpp"
+#include "Node.hpp"
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace eSGraph;
+
+static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "Scene format expects tightly packed glm::vec3");
+static_assert(sizeof(glm::quat) == 4 * sizeof(float), "Scene format expects tightly packed glm::quat");
+
+namespace {
+
+constexpr std::uint64_t ARRAY_ALIGNMENT = 16;
+
+std::uint64_t alignUp(std::uint64_t value)
+{
+    return (value + ARRAY_ALIGNMENT - 1) & ~(ARRAY_ALIGNMENT - 1);
+}
+
+template<typename T>
+std::uint64_t reserveArray(std::uint64_t& cursor, size_t count)
+{
+    const std::uint64_t offset = alignUp(cursor);
+    cursor = offset + count * sizeof(T);
+    return offset;
+}
+
+template<typename T>
+void copyArray(std::vector<std::byte>& out, std::uint64_t offset, const std::vector<T>& values)
+{
+    if (!values.empty())
+    {
+        std::memcpy(out.data() + offset, values.data(), values.size() * sizeof(T));
+    }
+}
+
+template<typename T>
+bool viewArray(std::span<const std::byte> data, std::uint64_t offset, std::uint64_t count, std::span<const T>& out)
+{
+    if (offset > data.size() || count > (data.size() - offset) / sizeof(T))
+    {
+        return false;
+    }
+
+    const std::byte* begin = data.data() + offset;
+    if (reinterpret_cast<std::uintptr_t>(begin) % alignof(T) != 0)
+    {
+        return false;
+    }
+
+    out = std::span<const T>(reinterpret_cast<const T*>(begin), static_cast<size_t>(count));
+    return true;
+}
+
+}
+
+std::vector<std::byte> SceneWriter::write(const Node& root)
+{
+    std::vector<std::uint32_t> parents;
+    std::vector<glm::vec3> positions;
+    std::vector<glm::quat> rotations;
+    std::vector<glm::vec3> scales;
+    std::vector<std::uint32_t> identifierIndices;
+    std::vector<std::uint32_t> identifierOffsets{0};
+    std::string strings;
+    std::unordered_map<std::string_view, std::uint32_t> interned;
+
+    std::vector<std::pair<const Node*, std::uint32_t>> stack;
+    stack.emplace_back(&root, SceneHeader::NO_PARENT);
+
+    while (!stack.empty())
+    {
+        auto [node, parent] = stack.back();
+        stack.pop_back();
+
+        const auto index = static_cast<std::uint32_t>(parents.size());
+        parents.push_back(parent);
+        positions.push_back(node->getPosition());
+        rotations.push_back(node->getRotation());
+        scales.push_back(node->getScale());
+
+        // Keys view the source nodes, which outlive this function
+        const std::string_view identifier = node->getIdentifier();
+        auto [it, inserted] = interned.try_emplace(identifier, static_cast<std::uint32_t>(interned.size()));
+        if (inserted)
+        {
+            strings.append(identifier);
+            identifierOffsets.push_back(static_cast<std::uint32_t>(strings.size()));
+        }
+        identifierIndices.push_back(it->second);
+
+        const auto& children = node->getChildren();
+        for (auto child = children.rbegin(); child != children.rend(); ++child)
+        {
+            stack.emplace_back(child->get(), index);
+        }
+    }
+
+    SceneHeader header;
+    header.nodeCount = static_cast<std::uint32_t>(parents.size());
+    header.identifierCount = static_cast<std::uint32_t>(interned.size());
+    header.stringBytes = static_cast<std::uint32_t>(strings.size());
+
+    std::uint64_t cursor = sizeof(SceneHeader);
+    header.parentsOffset = reserveArray<std::uint32_t>(cursor, parents.size());
+    header.positionsOffset = reserveArray<glm::vec3>(cursor, positions.size());
+    header.rotationsOffset = reserveArray<glm::quat>(cursor, rotations.size());
+    header.scalesOffset = reserveArray<glm::vec3>(cursor, scales.size());
+    header.identifierIndicesOffset = reserveArray<std::uint32_t>(cursor, identifierIndices.size());
+    header.identifierOffsetsOffset = reserveArray<std::uint32_t>(cursor, identifierOffsets.size());
+    header.stringsOffset = reserveArray<char>(cursor, strings.size());
+    header.totalBytes = cursor;
+
+    std::vector<std::byte> out(static_cast<size_t>(cursor));
+    std::memcpy(out.data(), &header, sizeof(SceneHeader));
+    copyArray(out, header.parentsOffset, parents);
+    copyArray(out, header.positionsOffset, positions);
+    copyArray(out, header.rotationsOffset, rotations);
+    copyArray(out, header.scalesOffset, scales);
+    copyArray(out, header.identifierIndicesOffset, identifierIndices);
+    copyArray(out, header.identifierOffsetsOffset, identifierOffsets);
+    if (!strings.empty())
+    {
+        std::memcpy(out.data() + header.stringsOffset, strings.data(), strings.size());
+    }
+    return out;
+}
+
+bool SceneWriter::writeFile(const Node& root, const std::string& path)
+{
+    const std::vector<std::byte> bytes = write(root);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
+
+std::optional<SceneView> SceneView::open(std::span<const std::byte> data)
+{
+    if (data.size() < sizeof(SceneHeader))
+    {
+        return std::nullopt;
+    }
+
+    SceneHeader header;
+    std::memcpy(&header, data.data(), sizeof(SceneHeader));
+    if (header.magic != SceneHeader::MAGIC ||
+        header.endianTag != SceneHeader::ENDIAN_TAG ||
+        header.version == 0 || header.version > SceneHeader::VERSION ||
+        header.nodeCount == 0 ||
+        header.totalBytes > data.size())
+    {
+        return std::nullopt;
+    }
+
+    SceneView view;
+    std::span<const char> strings;
+    if (!viewArray(data, header.parentsOffset, header.nodeCount, view.mParents) ||
+        !viewArray(data, header.positionsOffset, header.nodeCount, view.mPositions) ||
+        !viewArray(data, header.rotationsOffset, header.nodeCount, view.mRotations) ||
+        !viewArray(data, header.scalesOffset, header.nodeCount, view.mScales) ||
+        !viewArray(data, header.identifierIndicesOffset, header.nodeCount, view.mIdentifierIndices) ||
+        !viewArray(data, header.identifierOffsetsOffset, std::uint64_t{header.identifierCount} + 1, view.mIdentifierOffsets) ||
+        !viewArray(data, header.stringsOffset, header.stringBytes, strings))
+    {
+        return std::nullopt;
+    }
+    view.mStrings = strings.data();
+
+    if (view.mParents[0] != SceneHeader::NO_PARENT)
+    {
+        return std::nullopt;
+    }
+    for (size_t i = 1; i < view.mParents.size(); ++i)
+    {
+        if (view.mParents[i] >= i)
+        {
+            return std::nullopt;
+        }
+    }
+    for (std::uint32_t identifier : view.mIdentifierIndices)
+    {
+        if (identifier >= header.identifierCount)
+        {
+            return std::nullopt;
+        }
+    }
+    std::uint32_t previous = 0;
+    for (std::uint32_t offset : view.mIdentifierOffsets)
+    {
+        if (offset < previous || offset > header.stringBytes)
+        {
+            return std::nullopt;
+        }
+        previous = offset;
+    }
+
+    return view;
+}
+
+std::string_view SceneView::getIdentifier(size_t index) const noexcept
+{
+    const std::uint32_t identifier = mIdentifierIndices[index];
+    const std::uint32_t begin = mIdentifierOffsets[identifier];
+    const std::uint32_t end = mIdentifierOffsets[identifier + 1];
+    return {mStrings + begin, end - begin};
+}
+
+std::unique_ptr<Node> SceneView::instantiate() const
+{
+    const size_t count = size();
+
+    std::vector<std::uint32_t> childCounts(count, 0);
+    for (size_t i = 1; i < count; ++i)
+    {
+        ++childCounts[mParents[i]];
+    }
+
+    std::vector<Node*> created(count, nullptr);
+    std::unique_ptr<Node> root;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto node = std::make_unique<Node>(std::string(getIdentifier(i)));
+
+        // Linked directly like Node::clone(): new nodes start with dirty global state
+        // and empty layer masks, so neither a dirty walk nor a layer refresh is needed
+        node->mPosition = mPositions[i];
+        node->mRotation = glm::normalize(mRotations[i]);
+        node->mScale = mScales[i];
+        node->mChildren.reserve(childCounts[i]);
+        created[i] = node.get();
+
+        if (i == 0)
+        {
+            root = std::move(node);
+        }
+        else
+        {
+            Node* parent = created[mParents[i]];
+            node->mParent = parent;
+            node->mChildIndex = static_cast<std::uint32_t>(parent->mChildren.size());
+            parent->mChildren.push_back(std::move(node));
+        }
+    }
+    // One structure change for the whole tree
+    Node::bumpStructureEpoch();
+
+    return root;
+}
+
+MappedFile::MappedFile(const std::string& path)
+{
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        return;
+    }
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return;
+    }
+
+    mFile = file;
+    mMapping = mapping;
+    mData = static_cast<const std::byte*>(data);
+    mSize = static_cast<size_t>(size.QuadPart);
+#else
+    const int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+    {
+        return;
+    }
+
+    struct stat status{};
+    if (::fstat(descriptor, &status) != 0 || status.st_size <= 0)
+    {
+        ::close(descriptor);
+        return;
+    }
+
+    void* data = ::mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);  // The mapping keeps the file referenced
+    if (data == MAP_FAILED)
+    {
+        return;
+    }
+
+    mData = static_cast<const std::byte*>(data);
+    mSize = static_cast<size_t>(status.st_size);
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        mData = std::exchange(other.mData, nullptr);
+        mSize = std::exchange(other.mSize, 0);
+#if defined(_WIN32)
+        mFile = std::exchange(other.mFile, nullptr);
+        mMapping = std::exchange(other.mMapping, nullptr);
+#endif
+    }
+    return *this;
+}
+
+void MappedFile::close() noexcept
+{
+    if (mData == nullptr)
+    {
+        return;
+    }
+
+#if defined(_WIN32)
+    UnmapViewOfFile(mData);
+    CloseHandle(mMapping);
+    CloseHandle(mFile);
+    mFile = nullptr;
+    mMapping = nullptr;
+#else
+    ::munmap(const_cast<std::byte*>(mData), mSize);
+#endif
+    mData = nullptr;
+    mSize = 0;
+}
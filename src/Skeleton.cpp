@@ -0,0 +1,96 @@
+//
+//  Skeleton.cpp
+//  eSGraph
+//
+
+#include "Skeleton.hpp"
+#include "Node.hpp"
+#include <algorithm>
+#include <cassert>
+#include <new>
+#include <utility>
+
+using namespace eSGraph;
+
+Skeleton::Skeleton(Node& root)
+{
+    std::vector<Node*> stack{&root};
+    while (!stack.empty())
+    {
+        Node* current = stack.back();
+        stack.pop_back();
+        mJoints.push_back(current);
+
+        const auto& children = current->getChildren();
+        for (auto it = children.rbegin(); it != children.rend(); ++it)
+        {
+            stack.push_back(it->get());
+        }
+    }
+
+    mInverseBindMatrices.reserve(mJoints.size());
+    for (Node* joint : mJoints)
+    {
+        mInverseBindMatrices.push_back(glm::inverse(joint->getGlobalMatrix()));
+    }
+    allocatePalette();
+}
+
+Skeleton::Skeleton(std::vector<Node*> joints, std::span<const glm::mat4> inverseBindMatrices)
+    : mJoints{std::move(joints)}
+    , mInverseBindMatrices(inverseBindMatrices.begin(), inverseBindMatrices.end())
+{
+    assert(mJoints.size() == mInverseBindMatrices.size());
+    allocatePalette();
+}
+
+void Skeleton::AlignedDelete::operator()(glm::mat4* palette) const noexcept
+{
+    ::operator delete[](palette, std::align_val_t{PALETTE_ALIGNMENT});
+}
+
+void Skeleton::allocatePalette()
+{
+    const size_t count = std::max<size_t>(mJoints.size(), 1);
+    auto* storage = static_cast<glm::mat4*>(::operator new[](count * sizeof(glm::mat4), std::align_val_t{PALETTE_ALIGNMENT}));
+    for (size_t i = 0; i < count; ++i)
+    {
+        new (storage + i) glm::mat4(1.0f);
+    }
+    mPalette.reset(storage);
+
+    mVersions.assign(mJoints.size(), 0);
+    mChanged.reserve(mJoints.size());
+    mGlobals.reserve(mJoints.size());
+}
+
+size_t Skeleton::update()
+{
+    // Pass 1: bring world matrices up to date and gather the joints that changed.
+    // Clean joints cost a flag check and a version compare.
+    mChanged.clear();
+    mGlobals.clear();
+    for (size_t i = 0; i < mJoints.size(); ++i)
+    {
+        Node* joint = mJoints[i];
+        const glm::mat4& global = joint->getGlobalMatrix();
+        const std::uint32_t version = joint->getGlobalMatrixVersion();
+        if (mInitialized && version == mVersions[i])
+        {
+            continue;
+        }
+        mVersions[i] = version;
+        mChanged.push_back(static_cast<std::uint32_t>(i));
+        mGlobals.push_back(global);
+    }
+    mInitialized = true;
+
+    // Pass 2: multiply contiguous operands
+    glm::mat4* palette = mPalette.get();
+    for (size_t c = 0; c < mChanged.size(); ++c)
+    {
+        const std::uint32_t joint = mChanged[c];
+        palette[joint] = mGlobals[c] * mInverseBindMatrices[joint];
+    }
+    return mChanged.size();
+}
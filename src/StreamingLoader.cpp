@@ -0,0 +1,138 @@
+//
+//  StreamingLoader.cpp
+//  eSGraph
+//
+
+#include "StreamingLoader.hpp"
+#include "Node.hpp"
+#include "SceneFormat.hpp"
+#include <cassert>
+#include <utility>
+
+using namespace eSGraph;
+
+StreamingLoader::StreamingLoader(size_t queueCapacity)
+    : mDecoded{queueCapacity}
+    , mWorker{&StreamingLoader::run, this}
+{
+}
+
+StreamingLoader::~StreamingLoader()
+{
+    {
+        std::lock_guard<std::mutex> lock(mRequestMutex);
+        mStopping = true;
+    }
+    mRequestCondition.notify_one();
+    mWorker.join();
+}
+
+void StreamingLoader::request(std::vector<std::byte> sceneBytes, Node* parent)
+{
+    assert(parent != nullptr);
+    {
+        std::lock_guard<std::mutex> lock(mRequestMutex);
+        mRequests.push_back({std::move(sceneBytes), {}, parent});
+    }
+    ++mRequestedCount;
+    mRequestCondition.notify_one();
+}
+
+void StreamingLoader::request(std::string scenePath, Node* parent)
+{
+    assert(parent != nullptr);
+    {
+        std::lock_guard<std::mutex> lock(mRequestMutex);
+        mRequests.push_back({{}, std::move(scenePath), parent});
+    }
+    ++mRequestedCount;
+    mRequestCondition.notify_one();
+}
+
+size_t StreamingLoader::update(std::chrono::microseconds budget)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    size_t attached = 0;
+    Decoded decoded;
+    while (mDecoded.tryPop(decoded))
+    {
+        Node::attachTo(std::move(decoded.node), decoded.parent);
+        ++attached;
+
+        if (std::chrono::steady_clock::now() - start >= budget)
+        {
+            break;
+        }
+    }
+
+    mAttachedCount += attached;
+    return attached;
+}
+
+size_t StreamingLoader::getPendingCount() const noexcept
+{
+    return mRequestedCount - mAttachedCount - getFailedCount();
+}
+
+void StreamingLoader::run()
+{
+    while (true)
+    {
+        Request request;
+        {
+            std::unique_lock<std::mutex> lock(mRequestMutex);
+            mRequestCondition.wait(lock, [this] { return mStopping || !mRequests.empty(); });
+            if (mStopping)
+            {
+                return;
+            }
+            request = std::move(mRequests.front());
+            mRequests.pop_front();
+        }
+
+        Decoded decoded{decode(request), request.parent};
+        if (!decoded.node)
+        {
+            mFailedCount.fetch_add(1, std::memory_order_release);
+            continue;
+        }
+
+        while (!mDecoded.tryPush(std::move(decoded)))
+        {
+            // Main thread is behind; back off until a slot frees up
+            std::unique_lock<std::mutex> lock(mRequestMutex);
+            if (mRequestCondition.wait_for(lock, std::chrono::milliseconds(1), [this] { return mStopping; }))
+            {
+                return;
+            }
+        }
+    }
+}
+
+std::unique_ptr<Node> StreamingLoader::decode(const Request& request)
+{
+    std::unique_ptr<Node> root;
+    if (request.path.empty())
+    {
+        if (auto view = SceneView::open(request.bytes))
+        {
+            root = view->instantiate();
+        }
+    }
+    else
+    {
+        MappedFile file(request.path);
+        if (auto view = SceneView::open(file.getData()))
+        {
+            root = view->instantiate();
+        }
+    }
+
+    if (root)
+    {
+        // Detached and owned by this thread, so the local matrix cache can be filled here
+        root->traverse([](Node& node) { (void)node.getMatrix(); });
+    }
+    return root;
+}
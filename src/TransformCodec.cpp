@@ -0,0 +1,343 @@
+//
+//  TransformCodec.cpp
+//  eSGraph
+//
+
+#include "TransformCodec.hpp"
+#include "Node.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+using namespace eSGraph;
+
+namespace {
+
+constexpr float POSITION_STEPS = 65535.0f;
+constexpr float ROTATION_RANGE = 0.70710678f;
+constexpr float ROTATION_STEPS = 1023.0f;
+constexpr float HALF_MAX = 65504.0f;
+
+template<typename NodePointer>
+void collectPreOrder(NodePointer root, std::vector<NodePointer>& nodes)
+{
+    std::vector<NodePointer> stack;
+    stack.push_back(root);
+
+    while (!stack.empty())
+    {
+        NodePointer current = stack.back();
+        stack.pop_back();
+        nodes.push_back(current);
+
+        const auto& children = current->getChildren();
+        for (auto it = children.rbegin(); it != children.rend(); ++it)
+        {
+            stack.push_back(it->get());
+        }
+    }
+}
+
+}
+
+TransformCodec::TransformCodec(const PositionBounds& bounds)
+    : mBounds{bounds}
+{
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        const float extent = bounds.max[axis] - bounds.min[axis];
+        assert(extent >= 0.0f);
+        mScale[axis] = extent / POSITION_STEPS;
+        mInverseScale[axis] = extent > 0.0f ? POSITION_STEPS / extent : 0.0f;
+    }
+}
+
+glm::vec3 TransformCodec::getPositionError() const noexcept
+{
+    return mScale * 0.5f;
+}
+
+PositionBounds TransformCodec::computeBounds(std::span<const glm::vec3> positions)
+{
+    if (positions.empty())
+    {
+        return {};
+    }
+
+    PositionBounds bounds{positions.front(), positions.front()};
+    for (const glm::vec3& position : positions)
+    {
+        bounds.min = glm::min(bounds.min, position);
+        bounds.max = glm::max(bounds.max, position);
+    }
+    return bounds;
+}
+
+std::uint32_t TransformCodec::packRotation(const glm::quat& rotation) noexcept
+{
+    // Drop the largest component; the other three then lie in [-1/sqrt(2), 1/sqrt(2)]
+    const float components[4] = {rotation.x, rotation.y, rotation.z, rotation.w};
+    std::uint32_t largest = 0;
+    for (std::uint32_t i = 1; i < 4; ++i)
+    {
+        if (std::abs(components[i]) > std::abs(components[largest]))
+        {
+            largest = i;
+        }
+    }
+
+    // q and -q are the same rotation; make the dropped component positive
+    const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+    const float length = std::sqrt(components[0] * components[0] + components[1] * components[1] +
+                                   components[2] * components[2] + components[3] * components[3]);
+    const float normalize = length > 0.0f ? sign / length : 1.0f;
+
+    std::uint32_t packed = largest << 30;
+    int shift = 20;
+    for (std::uint32_t i = 0; i < 4; ++i)
+    {
+        if (i == largest)
+        {
+            continue;
+        }
+        const float value = std::clamp(components[i] * normalize, -ROTATION_RANGE, ROTATION_RANGE);
+        const auto quantized = static_cast<std::uint32_t>(
+            std::lround((value + ROTATION_RANGE) * (ROTATION_STEPS / (2.0f * ROTATION_RANGE))));
+        packed |= quantized << shift;
+        shift -= 10;
+    }
+    return packed;
+}
+
+glm::quat TransformCodec::unpackRotation(std::uint32_t packed) noexcept
+{
+    const std::uint32_t largest = packed >> 30;
+    float components[4];
+    float sumSquares = 0.0f;
+    int shift = 20;
+    for (std::uint32_t i = 0; i < 4; ++i)
+    {
+        if (i == largest)
+        {
+            continue;
+        }
+        const auto quantized = static_cast<float>((packed >> shift) & 0x3FF);
+        components[i] = quantized * (2.0f * ROTATION_RANGE / ROTATION_STEPS) - ROTATION_RANGE;
+        sumSquares += components[i] * components[i];
+        shift -= 10;
+    }
+    components[largest] = std::sqrt(std::max(0.0f, 1.0f - sumSquares));
+
+    return glm::normalize(glm::quat(components[3], components[0], components[1], components[2]));
+}
+
+std::uint16_t TransformCodec::packHalf(float value) noexcept
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const std::uint32_t sign = (bits >> 16) & 0x8000;
+    const std::uint32_t biasedExponent = (bits >> 23) & 0xFF;
+    std::uint32_t mantissa = bits & 0x7FFFFF;
+
+    if (biasedExponent == 0xFF)
+    {
+        return static_cast<std::uint16_t>(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+    }
+
+    const int exponent = static_cast<int>(biasedExponent) - 127 + 15;
+    if (exponent >= 31)
+    {
+        return static_cast<std::uint16_t>(sign | 0x7C00);
+    }
+
+    if (exponent <= 0)
+    {
+        if (exponent < -10)
+        {
+            return static_cast<std::uint16_t>(sign);
+        }
+        // Subnormal half: shift the implicit bit in and round to nearest even
+        mantissa |= 0x800000;
+        const int shift = 14 - exponent;
+        std::uint32_t half = mantissa >> shift;
+        const std::uint32_t remainder = mantissa & ((1u << shift) - 1);
+        const std::uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1)))
+        {
+            ++half;
+        }
+        return static_cast<std::uint16_t>(sign | half);
+    }
+
+    // A mantissa carry rolls over into the exponent, which is the correct result
+    std::uint32_t half = sign | (static_cast<std::uint32_t>(exponent) << 10) | (mantissa >> 13);
+    const std::uint32_t remainder = mantissa & 0x1FFF;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+    {
+        ++half;
+    }
+    return static_cast<std::uint16_t>(half);
+}
+
+float TransformCodec::unpackHalf(std::uint16_t half) noexcept
+{
+    const std::uint32_t sign = static_cast<std::uint32_t>(half & 0x8000) << 16;
+    const std::uint32_t exponent = (half >> 10) & 0x1F;
+    const std::uint32_t mantissa = half & 0x3FF;
+
+    if (exponent == 0)
+    {
+        const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -magnitude : magnitude;
+    }
+
+    std::uint32_t bits;
+    if (exponent == 31)
+    {
+        bits = sign | 0x7F800000 | (mantissa << 13);
+    }
+    else
+    {
+        bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+    }
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+void TransformCodec::encode(std::span<const glm::vec3> positions,
+                            std::span<const glm::quat> rotations,
+                            std::span<const glm::vec3> scales,
+                            std::span<PackedTransform> out,
+                            std::vector<glm::vec3>& nonUniformScales) const
+{
+    assert(positions.size() == out.size());
+    assert(rotations.size() == out.size());
+    assert(scales.size() == out.size());
+
+    // Separate passes per component keep each loop branch-free where possible so the
+    // compiler can vectorize them under the SIMD flags the library is built with
+    for (size_t i = 0; i < out.size(); ++i)
+    {
+        const glm::vec3 steps = glm::clamp((positions[i] - mBounds.min) * mInverseScale,
+                                           glm::vec3(0.0f), glm::vec3(POSITION_STEPS));
+        out[i].position[0] = static_cast<std::uint16_t>(steps.x + 0.5f);
+        out[i].position[1] = static_cast<std::uint16_t>(steps.y + 0.5f);
+        out[i].position[2] = static_cast<std::uint16_t>(steps.z + 0.5f);
+    }
+
+    for (size_t i = 0; i < out.size(); ++i)
+    {
+        out[i].rotation = packRotation(rotations[i]);
+    }
+
+    for (size_t i = 0; i < out.size(); ++i)
+    {
+        const glm::vec3& scale = scales[i];
+        const float tolerance = UNIFORM_SCALE_TOLERANCE * std::abs(scale.x);
+        const bool uniform = std::abs(scale.y - scale.x) <= tolerance &&
+                             std::abs(scale.z - scale.x) <= tolerance &&
+                             std::abs(scale.x) <= HALF_MAX;
+        if (uniform)
+        {
+            out[i].scale = packHalf(scale.x);
+        }
+        else
+        {
+            out[i].scale = NON_UNIFORM_SCALE;
+            nonUniformScales.push_back(scale);
+        }
+    }
+}
+
+bool TransformCodec::decode(std::span<const PackedTransform> packed,
+                            std::span<const glm::vec3> nonUniformScales,
+                            std::span<glm::vec3> positions,
+                            std::span<glm::quat> rotations,
+                            std::span<glm::vec3> scales) const
+{
+    assert(positions.size() == packed.size());
+    assert(rotations.size() == packed.size());
+    assert(scales.size() == packed.size());
+
+    for (size_t i = 0; i < packed.size(); ++i)
+    {
+        const glm::vec3 steps(static_cast<float>(packed[i].position[0]),
+                              static_cast<float>(packed[i].position[1]),
+                              static_cast<float>(packed[i].position[2]));
+        positions[i] = mBounds.min + steps * mScale;
+    }
+
+    for (size_t i = 0; i < packed.size(); ++i)
+    {
+        rotations[i] = unpackRotation(packed[i].rotation);
+    }
+
+    size_t nextNonUniform = 0;
+    for (size_t i = 0; i < packed.size(); ++i)
+    {
+        if (packed[i].scale != NON_UNIFORM_SCALE)
+        {
+            scales[i] = glm::vec3(unpackHalf(packed[i].scale));
+        }
+        else
+        {
+            if (nextNonUniform == nonUniformScales.size())
+            {
+                return false;
+            }
+            scales[i] = nonUniformScales[nextNonUniform++];
+        }
+    }
+    return true;
+}
+
+TransformCodec::EncodedSubtree TransformCodec::encodeSubtree(const Node& root)
+{
+    std::vector<const Node*> nodes;
+    collectPreOrder(&root, nodes);
+
+    std::vector<glm::vec3> positions;
+    std::vector<glm::quat> rotations;
+    std::vector<glm::vec3> scales;
+    positions.reserve(nodes.size());
+    rotations.reserve(nodes.size());
+    scales.reserve(nodes.size());
+    for (const Node* node : nodes)
+    {
+        positions.push_back(node->getPosition());
+        rotations.push_back(node->getRotation());
+        scales.push_back(node->getScale());
+    }
+
+    EncodedSubtree encoded;
+    encoded.bounds = computeBounds(positions);
+    encoded.transforms.resize(nodes.size());
+    TransformCodec(encoded.bounds).encode(positions, rotations, scales, encoded.transforms, encoded.nonUniformScales);
+    return encoded;
+}
+
+bool TransformCodec::decodeSubtree(const EncodedSubtree& encoded, Node& root)
+{
+    std::vector<Node*> nodes;
+    collectPreOrder(&root, nodes);
+    if (nodes.size() != encoded.transforms.size())
+    {
+        return false;
+    }
+
+    std::vector<glm::vec3> positions(nodes.size());
+    std::vector<glm::quat> rotations(nodes.size());
+    std::vector<glm::vec3> scales(nodes.size());
+    if (!TransformCodec(encoded.bounds).decode(encoded.transforms, encoded.nonUniformScales, positions, rotations, scales))
+    {
+        return false;
+    }
+
+    Node::setLocalTransforms(nodes, positions, rotations, scales);
+    return true;
+}
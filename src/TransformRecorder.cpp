@@ -0,0 +1,339 @@
+//
+//  TransformRecorder.cpp
+//  eSGraph
+//
+
+#include "TransformRecorder.hpp"
+#include "Node.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+using namespace eSGraph;
+
+namespace {
+
+constexpr std::uint8_t POSITION_BIT = static_cast<std::uint8_t>(TransformComponent::POSITION);
+constexpr std::uint8_t ROTATION_BIT = static_cast<std::uint8_t>(TransformComponent::ROTATION);
+constexpr std::uint8_t SCALE_BIT = static_cast<std::uint8_t>(TransformComponent::SCALE);
+constexpr float ROTATION_SCALE = 32767.0f;
+
+void writeVarint(std::vector<std::uint8_t>& out, std::uint32_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+bool readVarint(std::span<const std::uint8_t> in, size_t& cursor, std::uint32_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 35; shift += 7)
+    {
+        if (cursor >= in.size())
+        {
+            return false;
+        }
+        const std::uint8_t byte = in[cursor++];
+        value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename T>
+void writeRaw(std::vector<std::uint8_t>& out, const T& value)
+{
+    const size_t offset = out.size();
+    out.resize(offset + sizeof(T));
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+template<typename T>
+bool readRaw(std::span<const std::uint8_t> in, size_t& cursor, T& value)
+{
+    if (in.size() - cursor < sizeof(T))
+    {
+        return false;
+    }
+    std::memcpy(&value, in.data() + cursor, sizeof(T));
+    cursor += sizeof(T);
+    return true;
+}
+
+}
+
+TransformRecorder::TransformRecorder(float positionPrecision, float scalePrecision)
+    : mPositionPrecision{positionPrecision}
+    , mScalePrecision{scalePrecision}
+{
+    assert(positionPrecision > 0.0f && scalePrecision > 0.0f);
+}
+
+TransformRecorder::~TransformRecorder()
+{
+    for (Node* node : mNodes)
+    {
+        if (node)
+        {
+            node->mRecorder = nullptr;
+        }
+    }
+}
+
+std::uint32_t TransformRecorder::track(Node* node)
+{
+    assert(node != nullptr);
+    assert(node->mRecorder == nullptr);
+
+    const auto id = static_cast<std::uint32_t>(mNodes.size());
+    node->mRecorder = this;
+    node->mRecorderIndex = id;
+
+    mNodes.push_back(node);
+    mBaselines.push_back(quantize(*node));
+    mMarked.push_back(0);
+    return id;
+}
+
+void TransformRecorder::trackSubtree(Node& root)
+{
+    std::vector<Node*> stack;
+    stack.push_back(&root);
+
+    while (!stack.empty())
+    {
+        Node* current = stack.back();
+        stack.pop_back();
+
+        track(current);
+
+        const auto& children = current->getChildren();
+        for (auto it = children.rbegin(); it != children.rend(); ++it)
+        {
+            stack.push_back(it->get());
+        }
+    }
+}
+
+void TransformRecorder::untrack(Node* node)
+{
+    assert(node != nullptr && node->mRecorder == this);
+    forget(node->mRecorderIndex);
+    node->mRecorder = nullptr;
+}
+
+Node* TransformRecorder::getNode(std::uint32_t id) const noexcept
+{
+    return id < mNodes.size() ? mNodes[id] : nullptr;
+}
+
+void TransformRecorder::markChanged(std::uint32_t id)
+{
+    if (mApplying || mMarked[id])
+    {
+        return;
+    }
+    mMarked[id] = 1;
+    mChanged.push_back(id);
+}
+
+void TransformRecorder::forget(std::uint32_t id) noexcept
+{
+    // Keep the id reserved so the remaining ids stay stable
+    mNodes[id] = nullptr;
+}
+
+TransformRecorder::Quantized TransformRecorder::quantize(const Node& node) const
+{
+    Quantized quantized{};
+
+    const glm::vec3& position = node.getPosition();
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        quantized.position[axis] = static_cast<std::int32_t>(std::lround(position[axis] / mPositionPrecision));
+    }
+
+    // q and -q encode the same rotation; keep w non-negative so equal rotations compare equal
+    glm::quat rotation = node.getRotation();
+    if (rotation.w < 0.0f)
+    {
+        rotation = -rotation;
+    }
+    for (int component = 0; component < 4; ++component)
+    {
+        const float value = std::clamp(rotation[component], -1.0f, 1.0f);
+        quantized.rotation[component] = static_cast<std::int16_t>(std::lround(value * ROTATION_SCALE));
+    }
+
+    const glm::vec3& scale = node.getScale();
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        quantized.scale[axis] = static_cast<std::int32_t>(std::lround(scale[axis] / mScalePrecision));
+    }
+    return quantized;
+}
+
+void TransformRecorder::encodeDelta(std::vector<std::uint8_t>& out)
+{
+    std::sort(mChanged.begin(), mChanged.end());
+
+    writeRaw(out, mFrame);
+    const size_t countOffset = out.size();
+    std::vector<std::uint8_t> entries;
+
+    std::uint32_t entryCount = 0;
+    std::uint32_t previousId = 0;
+    for (std::uint32_t id : mChanged)
+    {
+        mMarked[id] = 0;
+        const Node* node = mNodes[id];
+        if (!node)
+        {
+            continue;
+        }
+
+        const Quantized current = quantize(*node);
+        Quantized& baseline = mBaselines[id];
+
+        std::uint8_t mask = 0;
+        if (std::memcmp(current.position, baseline.position, sizeof(current.position)) != 0)
+            mask |= POSITION_BIT;
+        if (std::memcmp(current.rotation, baseline.rotation, sizeof(current.rotation)) != 0)
+            mask |= ROTATION_BIT;
+        if (std::memcmp(current.scale, baseline.scale, sizeof(current.scale)) != 0)
+            mask |= SCALE_BIT;
+        if (mask == 0)
+        {
+            continue;
+        }
+
+        writeVarint(entries, id - previousId);
+        entries.push_back(mask);
+        if (mask & POSITION_BIT)
+            writeRaw(entries, current.position);
+        if (mask & ROTATION_BIT)
+            writeRaw(entries, current.rotation);
+        if (mask & SCALE_BIT)
+            writeRaw(entries, current.scale);
+
+        baseline = current;
+        previousId = id;
+        ++entryCount;
+    }
+
+    std::vector<std::uint8_t> count;
+    writeVarint(count, entryCount);
+    out.insert(out.begin() + static_cast<std::ptrdiff_t>(countOffset), count.begin(), count.end());
+    out.insert(out.end(), entries.begin(), entries.end());
+
+    mChanged.clear();
+    ++mFrame;
+}
+
+bool TransformRecorder::applyDelta(std::span<const std::uint8_t> delta)
+{
+    size_t cursor = 0;
+    std::uint32_t frame = 0;
+    std::uint32_t entryCount = 0;
+    if (!readRaw(delta, cursor, frame) || !readVarint(delta, cursor, entryCount))
+    {
+        return false;
+    }
+    if (frame != mExpectedFrame)
+    {
+        return false;
+    }
+
+    mApplyIds.clear();
+    mApplyMasks.clear();
+    mApplyValues.clear();
+    mApplyNodes.clear();
+    mApplyPositions.clear();
+    mApplyRotations.clear();
+    mApplyScales.clear();
+
+    std::uint32_t id = 0;
+    for (std::uint32_t entry = 0; entry < entryCount; ++entry)
+    {
+        std::uint32_t idDelta = 0;
+        std::uint8_t mask = 0;
+        if (!readVarint(delta, cursor, idDelta) || !readRaw(delta, cursor, mask))
+        {
+            return false;
+        }
+        id += idDelta;
+
+        Quantized values{};
+        if (((mask & POSITION_BIT) && !readRaw(delta, cursor, values.position)) ||
+            ((mask & ROTATION_BIT) && !readRaw(delta, cursor, values.rotation)) ||
+            ((mask & SCALE_BIT) && !readRaw(delta, cursor, values.scale)))
+        {
+            return false;
+        }
+
+        Node* node = getNode(id);
+        if (!node)
+        {
+            continue;
+        }
+
+        glm::vec3 position = node->getPosition();
+        glm::quat rotation = node->getRotation();
+        glm::vec3 scale = node->getScale();
+
+        if (mask & POSITION_BIT)
+        {
+            position = glm::vec3(static_cast<float>(values.position[0]),
+                                 static_cast<float>(values.position[1]),
+                                 static_cast<float>(values.position[2])) * mPositionPrecision;
+        }
+        if (mask & ROTATION_BIT)
+        {
+            rotation = glm::normalize(glm::quat(static_cast<float>(values.rotation[3]) / ROTATION_SCALE,
+                                                static_cast<float>(values.rotation[0]) / ROTATION_SCALE,
+                                                static_cast<float>(values.rotation[1]) / ROTATION_SCALE,
+                                                static_cast<float>(values.rotation[2]) / ROTATION_SCALE));
+        }
+        if (mask & SCALE_BIT)
+        {
+            scale = glm::vec3(static_cast<float>(values.scale[0]),
+                              static_cast<float>(values.scale[1]),
+                              static_cast<float>(values.scale[2])) * mScalePrecision;
+        }
+
+        mApplyIds.push_back(id);
+        mApplyMasks.push_back(mask);
+        mApplyValues.push_back(values);
+        mApplyNodes.push_back(node);
+        mApplyPositions.push_back(position);
+        mApplyRotations.push_back(rotation);
+        mApplyScales.push_back(scale);
+    }
+
+    mApplying = true;
+    Node::setLocalTransforms(mApplyNodes, mApplyPositions, mApplyRotations, mApplyScales);
+    mApplying = false;
+
+    for (size_t i = 0; i < mApplyIds.size(); ++i)
+    {
+        const std::uint8_t mask = mApplyMasks[i];
+        const Quantized& values = mApplyValues[i];
+        Quantized& baseline = mBaselines[mApplyIds[i]];
+        if (mask & POSITION_BIT)
+            std::memcpy(baseline.position, values.position, sizeof(values.position));
+        if (mask & ROTATION_BIT)
+            std::memcpy(baseline.rotation, values.rotation, sizeof(values.rotation));
+        if (mask & SCALE_BIT)
+            std::memcpy(baseline.scale, values.scale, sizeof(values.scale));
+    }
+    ++mExpectedFrame;
+    return true;
+}
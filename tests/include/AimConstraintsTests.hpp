@@ -0,0 +1,21 @@
+//
+//  AimConstraintsTests.hpp
+//  eSGraph
+//
+
+#ifndef AimConstraintsTests_h
+#define AimConstraintsTests_h
+
+#include "gtest/gtest.h"
+
+namespace eSGraph {
+
+class AimConstraintsTests : public testing::Test
+{
+protected:
+    void SetUp();
+    void TearDown();
+};
+
+}
+#endif /* AimConstraintsTests_h */
@@ -0,0 +1,21 @@
+//
+//  AnimationTests.hpp
+//  eSGraph
+//
+
+#ifndef AnimationTests_h
+#define AnimationTests_h
+
+#include "gtest/gtest.h"
+
+namespace eSGraph {
+
+class AnimationTests : public testing::Test
+{
+protected:
+    void SetUp();
+    void TearDown();
+};
+
+}
+#endif /* AnimationTests_h */
@@ -0,0 +1,21 @@
+//
+//  ConstraintStageTests.hpp
+//  eSGraph
+//
+
+#ifndef ConstraintStageTests_h
+#define ConstraintStageTests_h
+
+#include "gtest/gtest.h"
+
+namespace eSGraph {
+
+class ConstraintStageTests : public testing::Test
+{
+protected:
+    void SetUp();
+    void TearDown();
+};
+
+}
+#endif /* ConstraintStageTests_h */
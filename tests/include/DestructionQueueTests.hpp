@@ -0,0 +1,21 @@
+//
+//  DestructionQueueTests.hpp
+//  eSGraph
+//
+
+#ifndef DestructionQueueTests_h
+#define DestructionQueueTests_h
+
+#include "gtest/gtest.h"
+
+namespace eSGraph {
+
+class DestructionQueueTests : public testing::Test
+{
+protected:
+    void SetUp();
+    void TearDown();
+};
+
+}
+#endif /* DestructionQueueTests_h */
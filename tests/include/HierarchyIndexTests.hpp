@@ -0,0 +1,21 @@
+//
+//  HierarchyIndexTests.hpp
+//  eSGraph
+//
+
+#ifndef HierarchyIndexTests_h
+#define HierarchyIndexTests_h
+
+#include "gtest/gtest.h"
+
+namespace eSGraph {
+
+class HierarchyIndexTests : public testing::Test
+{
+protected:
+    void SetUp();
+    void TearDown();
+};
+
+}
+#endif /* HierarchyIndexTests_h */
@@ -0,0 +1,21 @@
+//
+//  InstanceSetTests.hpp
+//  eSGraph
+//
+
+#ifndef InstanceSetTests_h
+#define InstanceSetTests_h
+
+#include "gtest/gtest.h"
+
+namespace eSGraph {
+
+class InstanceSetTests : public testing::Test
+{
+protected:
+    void SetUp();
+    void TearDown();
+};
+
+}
+#endif /* InstanceSetTests_h */
@@ -0,0 +1,21 @@
+//
+//  InterpolationBufferTests.hpp
+//  eSGraph
+//
+
+#ifndef InterpolationBufferTests_h
+#define InterpolationBufferTests_h
+
+#include "gtest/gtest.h"
+
+namespace eSGraph {
+
+class InterpolationBufferTests : public testing::Test
+{
+protected:
+    void SetUp();
+    void TearDown();
+};
+
+}
+#endif /* InterpolationBufferTests_h */
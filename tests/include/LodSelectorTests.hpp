@@ -0,0 +1,21 @@
+//
+//  LodSelectorTests.hpp
+//  eSGraph
+//
+
+#ifndef LodSelectorTests_h
+#define LodSelectorTests_h
+
+#include "gtest/gtest.h"
+
+namespace eSGraph {
+
+class LodSelectorTests : public testing::Test
+{
+protected:
+    void SetUp();
+    void TearDown();
+};
+
+}
+#endif /* LodSelectorTests_h */
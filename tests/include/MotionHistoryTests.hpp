@@ -0,0 +1,21 @@
+//
+//  MotionHistoryTests.hpp
+//  eSGraph
+//
+
+#ifndef MotionHistoryTests_h
+#define MotionHistoryTests_h
+
+#include "gtest/gtest.h"
+
+namespace eSGraph {
+
+class MotionHistoryTests : public testing::Test
+{
+protected:
+    void SetUp();
+    void TearDown();
+};
+
+}
+#endif /* MotionHistoryTests_h */
@@ -0,0 +1,21 @@
+//
+//  PoseSetTests.hpp
+//  eSGraph
+//
+
+#ifndef PoseSetTests_h
+#define PoseSetTests_h
+
+#include "gtest/gtest.h"
+
+namespace eSGraph {
+
+class PoseSetTests : public testing::Test
+{
+protected:
+    void SetUp();
+    void TearDown();
+};
+
+}
+#endif /* PoseSetTests_h */
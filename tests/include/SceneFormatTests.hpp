@@ -0,0 +1,21 @@
+//
+//  SceneFormatTests.hpp
+//  eSGraph
+//
+
+#ifndef SceneFormatTests_h
+#define SceneFormatTests_h
+
+#include "gtest/gtest.h"
+
+namespace eSGraph {
+
+class SceneFormatTests : public testing::Test
+{
+protected:
+    void SetUp();
+    void TearDown();
+};
+
+}
+#endif /* SceneFormatTests_h */
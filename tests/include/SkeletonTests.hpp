@@ -0,0 +1,21 @@
+//
+//  SkeletonTests.hpp
+//  eSGraph
+//
+
+#ifndef SkeletonTests_h
+#define SkeletonTests_h
+
+#include "gtest/gtest.h"
+
+namespace eSGraph {
+
+class SkeletonTests : public testing::Test
+{
+protected:
+    void SetUp();
+    void TearDown();
+};
+
+}
+#endif /* SkeletonTests_h */
@@ -0,0 +1,21 @@
+//
+//  StreamingLoaderTests.hpp
+//  eSGraph
+//
+
+#ifndef StreamingLoaderTests_h
+#define StreamingLoaderTests_h
+
+#include "gtest/gtest.h"
+
+namespace eSGraph {
+
+class StreamingLoaderTests : public testing::Test
+{
+protected:
+    void SetUp();
+    void TearDown();
+};
+
+}
+#endif /* StreamingLoaderTests_h */
@@ -0,0 +1,21 @@
+//
+//  TransformCodecTests.hpp
+//  eSGraph
+//
+
+#ifndef TransformCodecTests_h
+#define TransformCodecTests_h
+
+#include "gtest/gtest.h"
+
+namespace eSGraph {
+
+class TransformCodecTests : public testing::Test
+{
+protected:
+    void SetUp();
+    void TearDown();
+};
+
+}
+#endif /* TransformCodecTests_h */
@@ -0,0 +1,21 @@
+//
+//  TransformRecorderTests.hpp
+//  eSGraph
+//
+
+#ifndef TransformRecorderTests_h
+#define TransformRecorderTests_h
+
+#include "gtest/gtest.h"
+
+namespace eSGraph {
+
+class TransformRecorderTests : public testing::Test
+{
+protected:
+    void SetUp();
+    void TearDown();
+};
+
+}
+#endif /* TransformRecorderTests_h */
@@ -0,0 +1,142 @@
+//
+//  AimConstraintsTests.cpp
+//  eSGraph
+//
+
+#include "AimConstraintsTests.hpp"
+#include "AimConstraints.hpp"
+#include "Node.hpp"
+#include <cmath>
+#include <memory>
+#include <gtest/gtest.h>
+
+using namespace eSGraph;
+
+namespace {
+
+void expectSameRotation(const glm::quat& actual, const glm::quat& expected)
+{
+    EXPECT_NEAR(std::abs(glm::dot(actual, expected)), 1.0f, 1e-5f);
+}
+
+}
+
+void AimConstraintsTests::SetUp()
+{
+}
+
+void AimConstraintsTests::TearDown()
+{
+}
+
+TEST_F(AimConstraintsTests, checkMatchesLookAt)
+{
+    auto base = std::make_unique<Node>("BASE");
+    base->setPosition(glm::vec3(2.0f, 0.0f, 0.0f));
+    base->setRotation(glm::angleAxis(glm::radians(30.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+    auto turret = std::make_unique<Node>("TURRET");
+    turret->setPosition(glm::vec3(0.0f, 1.0f, 0.0f));
+    Node* turretPtr = turret.get();
+    base->addChild(std::move(turret));
+
+    auto reference = base->clone();
+    Node* referenceTurret = reference->findByIdentifier("TURRET");
+
+    const glm::vec3 target(10.0f, 3.0f, -4.0f);
+    referenceTurret->lookAt(target);
+
+    AimConstraints constraints;
+    constraints.add(turretPtr, target);
+    constraints.solve();
+
+    expectSameRotation(turretPtr->getRotation(), referenceTurret->getRotation());
+    const glm::vec3 forward = turretPtr->getForward();
+    const glm::vec3 expected = glm::normalize(target - turretPtr->getPosition(Coordinates::WORLD));
+    EXPECT_NEAR(glm::dot(forward, expected), 1.0f, 1e-5f);
+}
+
+TEST_F(AimConstraintsTests, checkParentsSolvedBeforeChildren)
+{
+    auto root = std::make_unique<Node>("ROOT");
+    auto body = std::make_unique<Node>("BODY");
+    auto head = std::make_unique<Node>("HEAD");
+    head->setPosition(glm::vec3(0.0f, 0.0f, -1.0f));
+    Node* headPtr = head.get();
+    Node* bodyPtr = body.get();
+    body->addChild(std::move(head));
+    root->addChild(std::move(body));
+
+    auto target = std::make_unique<Node>("TARGET");
+    target->setPosition(glm::vec3(5.0f, 0.0f, 5.0f));
+    Node* targetPtr = target.get();
+    root->addChild(std::move(target));
+
+    // Registered child-first; depth ordering still aims the body first
+    AimConstraints constraints;
+    constraints.add(headPtr, targetPtr);
+    constraints.add(bodyPtr, glm::vec3(-10.0f, 0.0f, 0.0f));
+    constraints.solve();
+
+    EXPECT_NEAR(glm::dot(bodyPtr->getForward(), glm::vec3(-1.0f, 0.0f, 0.0f)), 1.0f, 1e-5f);
+    const glm::vec3 toTarget = glm::normalize(targetPtr->getPosition(Coordinates::WORLD) - headPtr->getPosition(Coordinates::WORLD));
+    EXPECT_NEAR(glm::dot(headPtr->getForward(), toTarget), 1.0f, 1e-5f);
+}
+
+TEST_F(AimConstraintsTests, checkRebasedRootSourceAimsFromOrigin)
+{
+    // The source sits at world zero once the origin is moved onto it
+    auto turret = std::make_unique<Node>("TURRET");
+    turret->setPosition(glm::vec3(100.0f, 0.0f, 0.0f));
+    turret->setOrigin(glm::dvec3(100.0, 0.0, 0.0));
+
+    AimConstraints constraints;
+    constraints.add(turret.get(), glm::vec3(10.0f, 0.0f, 0.0f));
+    constraints.solve();
+
+    EXPECT_NEAR(glm::dot(turret->getForward(), glm::vec3(1.0f, 0.0f, 0.0f)), 1.0f, 1e-5f);
+}
+
+TEST_F(AimConstraintsTests, checkRebasedRootSourceKeepsDoublePrecision)
+{
+    // The source sits 10 mm from the origin, below the float spacing at 150 km; a
+    // target at 13 mm on the same axis only lies ahead if the offset survives
+    auto turret = std::make_unique<Node>("TURRET");
+    turret->setPosition(glm::vec3(150000.0f, 0.0f, 0.0f));
+    turret->setOrigin(glm::dvec3(149999.99, 0.0, 0.0));
+
+    AimConstraints constraints;
+    constraints.add(turret.get(), glm::vec3(0.013f, 0.0f, 0.0f));
+    constraints.solve();
+
+    EXPECT_NEAR(glm::dot(turret->getForward(), glm::vec3(1.0f, 0.0f, 0.0f)), 1.0f, 1e-5f);
+}
+
+TEST_F(AimConstraintsTests, checkWeightBlendsRotation)
+{
+    auto node = std::make_unique<Node>("NODE");
+    AimConstraints constraints;
+    const size_t index = constraints.add(node.get(), glm::vec3(10.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), 0.5f);
+    EXPECT_FLOAT_EQ(constraints.getWeight(index), 0.5f);
+
+    // Forward is -Z; the full aim is 90 degrees to +X, half weight gives 45 degrees
+    constraints.solve();
+    EXPECT_NEAR(glm::degrees(glm::angle(node->getRotation())), 45.0f, 1e-3f);
+
+    // Solving again blends from the unconstrained rotation, not the last result
+    constraints.solve();
+    EXPECT_NEAR(glm::degrees(glm::angle(node->getRotation())), 45.0f, 1e-3f);
+
+    // A rotation written from outside becomes the new unconstrained rotation; this one
+    // already aims at the target, so the blend lands on it
+    node->setRotation(glm::angleAxis(glm::radians(-90.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+    constraints.solve();
+    EXPECT_NEAR(glm::degrees(glm::angle(node->getRotation())), 90.0f, 1e-2f);
+
+    constraints.setWeight(index, 0.0f);
+    const glm::quat before = node->getRotation();
+    constraints.solve();
+    expectSameRotation(node->getRotation(), before);
+
+    constraints.remove(index);
+    EXPECT_EQ(constraints.size(), 0u);
+}
@@ -0,0 +1,123 @@
+//
+//  AnimationTests.cpp
+//  eSGraph
+//
+
+#include "AnimationTests.hpp"
+#include "Animation.hpp"
+#include "Node.hpp"
+#include <cmath>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace eSGraph;
+
+namespace {
+
+std::unique_ptr<Node> makeArm()
+{
+    auto root = std::make_unique<Node>("ROOT");
+    auto shoulder = std::make_unique<Node>("SHOULDER");
+    shoulder->addChild(std::make_unique<Node>("ELBOW"));
+    root->addChild(std::move(shoulder));
+    return root;
+}
+
+}
+
+void AnimationTests::SetUp()
+{
+}
+
+void AnimationTests::TearDown()
+{
+}
+
+TEST_F(AnimationTests, checkSampleInterpolatesKeys)
+{
+    AnimationClip clip(2.0f);
+    const std::vector<float> times = {0.0f, 1.0f, 2.0f};
+    const std::vector<glm::vec3> positions = {{0.0f, 0.0f, 0.0f}, {10.0f, 0.0f, 0.0f}, {10.0f, 10.0f, 0.0f}};
+    const std::vector<glm::quat> rotations = {
+        glm::quat(1.0f, 0.0f, 0.0f, 0.0f),
+        glm::angleAxis(glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f)),
+        glm::angleAxis(glm::radians(180.0f), glm::vec3(0.0f, 0.0f, 1.0f))};
+    clip.addPositionTrack("SHOULDER", times, positions);
+    clip.addRotationTrack("ELBOW", times, rotations);
+
+    auto root = makeArm();
+    Node* shoulder = root->findByIdentifier("SHOULDER");
+    Node* elbow = root->findByIdentifier("ELBOW");
+    elbow->setPosition(glm::vec3(0.0f, 5.0f, 0.0f));
+
+    AnimationBinding binding(clip, *root);
+    EXPECT_EQ(binding.getBoundNodeCount(), 2u);
+
+    binding.apply(0.5f);
+    EXPECT_NEAR(shoulder->getPosition().x, 5.0f, 1e-5f);
+    EXPECT_NEAR(glm::degrees(glm::angle(elbow->getRotation())), 45.0f, 1e-3f);
+    // Channels without a track keep their value
+    EXPECT_NEAR(elbow->getPosition().y, 5.0f, 1e-6f);
+
+    binding.apply(1.5f);
+    EXPECT_NEAR(shoulder->getPosition().y, 5.0f, 1e-5f);
+    EXPECT_NEAR(glm::degrees(glm::angle(elbow->getRotation())), 135.0f, 1e-3f);
+
+    // Seeking backwards and past the end
+    binding.apply(0.25f);
+    EXPECT_NEAR(shoulder->getPosition().x, 2.5f, 1e-5f);
+    binding.apply(5.0f);
+    EXPECT_NEAR(shoulder->getPosition().y, 10.0f, 1e-5f);
+
+    // The batched write invalidates cached world matrices
+    const glm::vec3 world = elbow->getPosition(Coordinates::WORLD);
+    EXPECT_NEAR(world.x, 10.0f, 1e-4f);
+    EXPECT_NEAR(world.y, 15.0f, 1e-4f);
+}
+
+TEST_F(AnimationTests, checkRedundantKeysAreDropped)
+{
+    AnimationClip clip(3.0f);
+    const std::vector<float> times = {0.0f, 1.0f, 2.0f, 3.0f};
+
+    // Linear motion: only the end keys are needed
+    const std::vector<glm::vec3> linear = {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {2.0f, 0.0f, 0.0f}, {3.0f, 0.0f, 0.0f}};
+    clip.addPositionTrack("SHOULDER", times, linear);
+    EXPECT_EQ(clip.getKeyCount(AnimationChannel::POSITION), 2u);
+
+    // Constant: a single key
+    const std::vector<glm::vec3> constant(4, glm::vec3(2.0f));
+    clip.addScaleTrack("SHOULDER", times, constant);
+    EXPECT_EQ(clip.getKeyCount(AnimationChannel::SCALE), 1u);
+
+    // A corner keeps its key
+    const std::vector<glm::vec3> corner = {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {1.0f, 2.0f, 0.0f}};
+    clip.addPositionTrack("ELBOW", times, corner);
+    EXPECT_EQ(clip.getKeyCount(AnimationChannel::POSITION), 5u);
+    EXPECT_EQ(clip.getTrackCount(), 3u);
+
+    auto root = makeArm();
+    AnimationBinding binding(clip, *root);
+    binding.apply(1.5f);
+    EXPECT_NEAR(root->findByIdentifier("SHOULDER")->getPosition().x, 1.5f, 1e-5f);
+    EXPECT_NEAR(root->findByIdentifier("SHOULDER")->getScale().z, 2.0f, 1e-6f);
+    EXPECT_NEAR(root->findByIdentifier("ELBOW")->getPosition().y, 0.5f, 1e-5f);
+}
+
+TEST_F(AnimationTests, checkUnboundTracksAreSkipped)
+{
+    AnimationClip clip(1.0f);
+    const std::vector<float> times = {0.0f, 1.0f};
+    const std::vector<glm::vec3> values = {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}};
+    clip.addPositionTrack("TAIL", times, values);
+    clip.addPositionTrack("ROOT", times, values);
+
+    auto root = makeArm();
+    AnimationBinding binding(clip, *root);
+    EXPECT_EQ(binding.getBoundNodeCount(), 1u);
+    EXPECT_EQ(binding.getUnboundTrackCount(), 1u);
+
+    binding.apply(1.0f);
+    EXPECT_NEAR(root->getPosition().x, 1.0f, 1e-6f);
+}
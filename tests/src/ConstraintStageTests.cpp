@@ -0,0 +1,206 @@
+//
+//  ConstraintStageTests.cpp
+//  eSGraph
+//
+
+#include "ConstraintStageTests.hpp"
+#include "ConstraintStage.hpp"
+#include "Node.hpp"
+#include <cmath>
+#include <memory>
+#include <gtest/gtest.h>
+
+using namespace eSGraph;
+
+namespace {
+
+void expectVec3Near(const glm::vec3& actual, const glm::vec3& expected, float tolerance = 1e-4f)
+{
+    EXPECT_NEAR(actual.x, expected.x, tolerance);
+    EXPECT_NEAR(actual.y, expected.y, tolerance);
+    EXPECT_NEAR(actual.z, expected.z, tolerance);
+}
+
+}
+
+void ConstraintStageTests::SetUp()
+{
+}
+
+void ConstraintStageTests::TearDown()
+{
+}
+
+TEST_F(ConstraintStageTests, checkPositionConstraintWritesWorldCache)
+{
+    auto root = std::make_unique<Node>("ROOT");
+    auto follower = std::make_unique<Node>("FOLLOWER");
+    auto attachment = std::make_unique<Node>("ATTACHMENT");
+    attachment->setPosition(glm::vec3(0.0f, 1.0f, 0.0f));
+    Node* followerPtr = follower.get();
+    Node* attachmentPtr = attachment.get();
+    follower->addChild(std::move(attachment));
+    root->addChild(std::move(follower));
+
+    auto target = std::make_unique<Node>("TARGET");
+    target->setPosition(glm::vec3(4.0f, 0.0f, 2.0f));
+    Node* targetPtr = target.get();
+    root->addChild(std::move(target));
+
+    ConstraintStage stage;
+    stage.addPositionConstraint(followerPtr, targetPtr);
+    stage.evaluate();
+
+    // Local TRS is untouched; world queries and children see the constrained result
+    expectVec3Near(followerPtr->getPosition(), glm::vec3(0.0f));
+    expectVec3Near(followerPtr->getPosition(Coordinates::WORLD), glm::vec3(4.0f, 0.0f, 2.0f));
+    expectVec3Near(attachmentPtr->getPosition(Coordinates::WORLD), glm::vec3(4.0f, 1.0f, 2.0f));
+
+    // Evaluating again does not accumulate, and half weight blends with the input
+    stage.setWeight(0, 0.5f);
+    stage.evaluate();
+    expectVec3Near(followerPtr->getPosition(Coordinates::WORLD), glm::vec3(2.0f, 0.0f, 1.0f));
+
+    // Writing the local transform drops the override until the next evaluate
+    followerPtr->setPosition(glm::vec3(-1.0f, 0.0f, 0.0f));
+    expectVec3Near(followerPtr->getPosition(Coordinates::WORLD), glm::vec3(-1.0f, 0.0f, 0.0f));
+}
+
+TEST_F(ConstraintStageTests, checkParentAndOrientationConstraints)
+{
+    auto root = std::make_unique<Node>("ROOT");
+    auto hand = std::make_unique<Node>("HAND");
+    auto sword = std::make_unique<Node>("SWORD");
+    auto compass = std::make_unique<Node>("COMPASS");
+    hand->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    sword->setPosition(glm::vec3(1.0f, 0.5f, 0.0f));
+    compass->setPosition(glm::vec3(0.0f, 0.0f, 3.0f));
+    Node* handPtr = hand.get();
+    Node* swordPtr = sword.get();
+    Node* compassPtr = compass.get();
+    root->addChild(std::move(hand));
+    root->addChild(std::move(sword));
+    root->addChild(std::move(compass));
+
+    ConstraintStage stage;
+    stage.addParentConstraint(swordPtr, handPtr);
+    stage.addOrientationConstraint(compassPtr, handPtr);
+    EXPECT_EQ(stage.getType(1), ConstraintType::ORIENTATION);
+
+    const glm::quat turn = glm::angleAxis(glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    handPtr->setRotation(turn);
+    stage.evaluate();
+
+    // The sword keeps its 0.5 offset above the hand, rotating with it
+    expectVec3Near(swordPtr->getPosition(Coordinates::WORLD), glm::vec3(1.0f, 0.5f, 0.0f));
+    EXPECT_NEAR(std::abs(glm::dot(swordPtr->getRotation(Coordinates::WORLD), turn)), 1.0f, 1e-5f);
+
+    expectVec3Near(compassPtr->getPosition(Coordinates::WORLD), glm::vec3(0.0f, 0.0f, 3.0f));
+    EXPECT_NEAR(std::abs(glm::dot(compassPtr->getRotation(Coordinates::WORLD), turn)), 1.0f, 1e-5f);
+    expectVec3Near(compassPtr->getForward(), glm::vec3(-1.0f, 0.0f, 0.0f));
+}
+
+TEST_F(ConstraintStageTests, checkRebasedRootKeepsOriginRelativePosition)
+{
+    auto ship = std::make_unique<Node>("SHIP");
+    ship->setPosition(glm::vec3(100.0f, 0.0f, 0.0f));
+    ship->setOrigin(glm::dvec3(100.0, 0.0, 0.0));
+    auto target = std::make_unique<Node>("TARGET");
+    target->setRotation(glm::angleAxis(glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+
+    ConstraintStage stage;
+    stage.addOrientationConstraint(ship.get(), target.get());
+    stage.evaluate();
+
+    // Only the rotation is constrained; the root stays at the floating origin
+    expectVec3Near(ship->getPosition(Coordinates::WORLD), glm::vec3(0.0f));
+    expectVec3Near(ship->getForward(), glm::vec3(-1.0f, 0.0f, 0.0f));
+}
+
+TEST_F(ConstraintStageTests, checkRebasedRootKeepsDoublePrecisionOffset)
+{
+    // A float at 150 km has a spacing of ~16 mm, well above this offset
+    auto ship = std::make_unique<Node>("SHIP");
+    ship->setPosition(glm::vec3(150000.0f, 0.0f, 0.0f));
+    ship->setOrigin(glm::dvec3(149999.99, 0.0, 0.0));
+    auto target = std::make_unique<Node>("TARGET");
+
+    ConstraintStage stage;
+    stage.addOrientationConstraint(ship.get(), target.get());
+    stage.evaluate();
+
+    EXPECT_NEAR(ship->getGlobalMatrix()[3].x, 0.01f, 1e-3f);
+}
+
+TEST_F(ConstraintStageTests, checkTwoBoneIKReachesTarget)
+{
+    auto root = std::make_unique<Node>("ROOT");
+    auto shoulder = std::make_unique<Node>("SHOULDER");
+    auto elbow = std::make_unique<Node>("ELBOW");
+    auto wrist = std::make_unique<Node>("WRIST");
+    shoulder->setPosition(glm::vec3(0.0f, 2.0f, 0.0f));
+    elbow->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    elbow->setRotation(glm::angleAxis(glm::radians(-20.0f), glm::vec3(0.0f, 0.0f, 1.0f)));
+    wrist->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    Node* shoulderPtr = shoulder.get();
+    Node* elbowPtr = elbow.get();
+    Node* wristPtr = wrist.get();
+    elbow->addChild(std::move(wrist));
+    shoulder->addChild(std::move(elbow));
+    root->addChild(std::move(shoulder));
+
+    auto target = std::make_unique<Node>("TARGET");
+    Node* targetPtr = target.get();
+    root->addChild(std::move(target));
+
+    ConstraintStage stage;
+    stage.addTwoBoneIK(shoulderPtr, elbowPtr, wristPtr, targetPtr);
+
+    for (const glm::vec3& goal : {glm::vec3(1.2f, 2.5f, 0.3f), glm::vec3(-0.5f, 1.0f, 1.0f), glm::vec3(0.0f, 2.0f, 1.5f)})
+    {
+        targetPtr->setPosition(goal);
+        stage.evaluate();
+        expectVec3Near(wristPtr->getPosition(Coordinates::WORLD), goal, 1e-3f);
+
+        // Bone lengths are preserved
+        const glm::vec3 s = shoulderPtr->getPosition(Coordinates::WORLD);
+        const glm::vec3 e = elbowPtr->getPosition(Coordinates::WORLD);
+        const glm::vec3 w = wristPtr->getPosition(Coordinates::WORLD);
+        EXPECT_NEAR(glm::length(e - s), 1.0f, 1e-4f);
+        EXPECT_NEAR(glm::length(w - e), 1.0f, 1e-4f);
+    }
+
+    // Out of reach: the chain stretches toward the target
+    targetPtr->setPosition(glm::vec3(5.0f, 2.0f, 0.0f));
+    stage.evaluate();
+    const glm::vec3 wristWorld = wristPtr->getPosition(Coordinates::WORLD);
+    EXPECT_NEAR(wristWorld.x, 2.0f, 1e-2f);
+    EXPECT_NEAR(wristWorld.y, 2.0f, 1e-2f);
+}
+
+TEST_F(ConstraintStageTests, checkDependencyOrder)
+{
+    auto root = std::make_unique<Node>("ROOT");
+    auto a = std::make_unique<Node>("A");
+    auto b = std::make_unique<Node>("B");
+    auto c = std::make_unique<Node>("C");
+    auto anchor = std::make_unique<Node>("ANCHOR");
+    anchor->setPosition(glm::vec3(7.0f, 0.0f, 0.0f));
+    Node* aPtr = a.get();
+    Node* bPtr = b.get();
+    Node* cPtr = c.get();
+    Node* anchorPtr = anchor.get();
+    root->addChild(std::move(a));
+    root->addChild(std::move(b));
+    root->addChild(std::move(c));
+    root->addChild(std::move(anchor));
+
+    // Registered last-to-first: C follows B, B follows A, A follows ANCHOR
+    ConstraintStage stage;
+    stage.addPositionConstraint(cPtr, bPtr);
+    stage.addPositionConstraint(bPtr, aPtr);
+    stage.addPositionConstraint(aPtr, anchorPtr);
+    stage.evaluate();
+
+    expectVec3Near(cPtr->getPosition(Coordinates::WORLD), glm::vec3(7.0f, 0.0f, 0.0f));
+}
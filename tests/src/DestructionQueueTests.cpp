@@ -0,0 +1,149 @@
+//
+//  DestructionQueueTests.cpp
+//  eSGraph
+//
+
+#include "DestructionQueueTests.hpp"
+#include "DestructionQueue.hpp"
+#include "Node.hpp"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <gtest/gtest.h>
+
+using namespace eSGraph;
+
+namespace {
+
+std::atomic<size_t> g_destroyed{0};
+
+class CountedNode : public Node
+{
+public:
+    ~CountedNode() override { g_destroyed.fetch_add(1, std::memory_order_relaxed); }
+};
+
+std::unique_ptr<Node> buildChain(size_t depth)
+{
+    std::unique_ptr<Node> chain = std::make_unique<CountedNode>();
+    Node* current = chain.get();
+    for (size_t i = 1; i < depth; ++i)
+    {
+        auto child = std::make_unique<CountedNode>();
+        Node* childPtr = child.get();
+        current->addChild(std::move(child));
+        current = childPtr;
+    }
+    return chain;
+}
+
+std::unique_ptr<Node> buildWide(size_t branches, size_t leaves)
+{
+    auto root = std::make_unique<CountedNode>();
+    for (size_t i = 0; i < branches; ++i)
+    {
+        auto branch = std::make_unique<CountedNode>();
+        for (size_t j = 0; j < leaves; ++j)
+        {
+            branch->addChild(std::make_unique<CountedNode>());
+        }
+        root->addChild(std::move(branch));
+    }
+    return root;
+}
+
+}
+
+void DestructionQueueTests::SetUp()
+{
+    g_destroyed = 0;
+}
+
+void DestructionQueueTests::TearDown()
+{
+}
+
+TEST_F(DestructionQueueTests, checkDeepChainDestroysWithoutRecursion)
+{
+    // Deep enough to overflow the stack with a recursive destructor
+    std::unique_ptr<Node> chain = buildChain(500000);
+    chain.reset();
+    EXPECT_EQ(g_destroyed.load(), 500000u);
+}
+
+TEST_F(DestructionQueueTests, checkTimeSlicedUpdateDestroysIncrementally)
+{
+    DestructionQueue queue;
+    queue.push(buildWide(10, 100));
+    queue.push(buildChain(1000));
+    EXPECT_EQ(g_destroyed.load(), 0u);
+
+    // A spent budget still makes progress, but stops long before the end
+    const size_t destroyed = queue.update(std::chrono::microseconds(0));
+    EXPECT_GT(destroyed, 0u);
+    EXPECT_LT(destroyed, 2011u);
+    EXPECT_EQ(g_destroyed.load(), destroyed);
+
+    size_t total = destroyed;
+    while (queue.getPendingCount() > 0)
+    {
+        total += queue.update(std::chrono::microseconds(50));
+    }
+    EXPECT_EQ(total, 2011u);
+    EXPECT_EQ(g_destroyed.load(), 2011u);
+}
+
+TEST_F(DestructionQueueTests, checkTimeSlicedAcceptsPushesFromOtherThreads)
+{
+    DestructionQueue queue;
+    std::atomic<bool> done{false};
+    std::thread producer([&queue, &done]
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            queue.push(buildWide(2, 2));
+        }
+        done = true;
+    });
+
+    size_t total = 0;
+    while (!done || queue.getPendingCount() > 0)
+    {
+        total += queue.update(std::chrono::microseconds(50));
+    }
+    producer.join();
+    total += queue.update(std::chrono::microseconds(50));
+    EXPECT_EQ(total, 700u);
+    EXPECT_EQ(g_destroyed.load(), 700u);
+}
+
+TEST_F(DestructionQueueTests, checkFlushAndDestructorReleaseEverything)
+{
+    {
+        DestructionQueue queue;
+        queue.push(buildWide(4, 4));
+        queue.flush();
+        EXPECT_EQ(g_destroyed.load(), 21u);
+        EXPECT_EQ(queue.getPendingCount(), 0u);
+
+        queue.push(buildChain(5));
+    }
+    EXPECT_EQ(g_destroyed.load(), 26u);
+}
+
+TEST_F(DestructionQueueTests, checkBackgroundWorkerDestroysSubtrees)
+{
+    {
+        DestructionQueue queue(DestructionMode::BACKGROUND);
+        EXPECT_EQ(queue.getMode(), DestructionMode::BACKGROUND);
+        queue.push(buildWide(20, 50));
+        queue.push(buildChain(10000));
+        queue.flush();
+        EXPECT_EQ(g_destroyed.load(), 11021u);
+
+        // Whatever is still queued at destruction is drained before the worker stops
+        queue.push(buildChain(100));
+    }
+    EXPECT_EQ(g_destroyed.load(), 11121u);
+}
@@ -0,0 +1,126 @@
+//
+//  HierarchyIndexTests.cpp
+//  eSGraph
+//
+
+#include "HierarchyIndexTests.hpp"
+#include "HierarchyIndex.hpp"
+#include "Node.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace eSGraph;
+
+namespace {
+
+// ROOT -> A -> (A0, A1 -> A10), B
+struct SampleTree
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    Node* a = nullptr;
+    Node* a0 = nullptr;
+    Node* a1 = nullptr;
+    Node* a10 = nullptr;
+    Node* b = nullptr;
+
+    SampleTree()
+    {
+        auto nodeA = std::make_unique<Node>("A");
+        auto nodeA0 = std::make_unique<Node>("A0");
+        auto nodeA1 = std::make_unique<Node>("A1");
+        auto nodeA10 = std::make_unique<Node>("A10");
+        auto nodeB = std::make_unique<Node>("B");
+        a = nodeA.get();
+        a0 = nodeA0.get();
+        a1 = nodeA1.get();
+        a10 = nodeA10.get();
+        b = nodeB.get();
+        nodeA1->addChild(std::move(nodeA10));
+        nodeA->addChild(std::move(nodeA0));
+        nodeA->addChild(std::move(nodeA1));
+        root->addChild(std::move(nodeA));
+        root->addChild(std::move(nodeB));
+    }
+};
+
+}
+
+void HierarchyIndexTests::SetUp()
+{
+}
+
+void HierarchyIndexTests::TearDown()
+{
+}
+
+TEST_F(HierarchyIndexTests, checkAncestorQueriesMatchPointerWalk)
+{
+    SampleTree tree;
+    HierarchyIndex index(*tree.root);
+
+    const std::vector<Node*> nodes = {tree.root.get(), tree.a, tree.a0, tree.a1, tree.a10, tree.b};
+    for (Node* ancestor : nodes)
+    {
+        for (Node* node : nodes)
+        {
+            EXPECT_EQ(index.isAncestorOf(*ancestor, *node), node->isDescendantOf(ancestor))
+                << ancestor->getIdentifier() << " / " << node->getIdentifier();
+        }
+    }
+    EXPECT_EQ(index.size(), 6u);
+}
+
+TEST_F(HierarchyIndexTests, checkDepthAndSubtreeSize)
+{
+    SampleTree tree;
+    HierarchyIndex index(*tree.root);
+
+    EXPECT_EQ(index.getDepth(*tree.root), 0u);
+    EXPECT_EQ(index.getDepth(*tree.a1), 2u);
+    EXPECT_EQ(index.getDepth(*tree.a10), tree.a10->getDepth());
+    EXPECT_EQ(index.getSubtreeSize(*tree.root), 6u);
+    EXPECT_EQ(index.getSubtreeSize(*tree.a), 4u);
+    EXPECT_EQ(index.getSubtreeSize(*tree.b), 1u);
+}
+
+TEST_F(HierarchyIndexTests, checkRebuildsAfterStructuralChanges)
+{
+    SampleTree tree;
+    HierarchyIndex index(*tree.root);
+    EXPECT_TRUE(index.isAncestorOf(*tree.a, *tree.a10));
+    EXPECT_FALSE(index.isStale());
+
+    // Moving A1 under B deep inside the tree invalidates the index on the root
+    std::unique_ptr<Node> moved = tree.a->removeChild(tree.a1);
+    EXPECT_TRUE(index.isStale());
+    tree.b->addChild(std::move(moved));
+
+    EXPECT_FALSE(index.isAncestorOf(*tree.a, *tree.a10));
+    EXPECT_TRUE(index.isAncestorOf(*tree.b, *tree.a10));
+    EXPECT_EQ(index.getDepth(*tree.a10), 3u);
+    EXPECT_FALSE(index.isStale());
+
+    // Transform changes leave it alone
+    tree.a10->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_FALSE(index.isStale());
+}
+
+TEST_F(HierarchyIndexTests, checkDetachedSubtreeIndexSeesLaterChanges)
+{
+    SampleTree tree;
+    std::unique_ptr<Node> subtree = tree.a->detach();
+    HierarchyIndex index(*subtree);
+    EXPECT_EQ(index.getSubtreeSize(*subtree), 4u);
+
+    // Attached, modified and detached again: the index still rebuilds
+    tree.root->addChild(std::move(subtree));
+    tree.a->addChild(std::make_unique<Node>("A2"));
+    subtree = tree.a->detach();
+    EXPECT_TRUE(index.isStale());
+    EXPECT_EQ(index.getSubtreeSize(*subtree), 5u);
+
+    std::vector<std::unique_ptr<Node>> children = subtree->removeAllChildren();
+    EXPECT_EQ(index.getSubtreeSize(*subtree), 1u);
+}
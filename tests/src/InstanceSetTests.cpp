@@ -0,0 +1,173 @@
+//
+//  InstanceSetTests.cpp
+//  eSGraph
+//
+
+#include "InstanceSetTests.hpp"
+#include "InstanceSet.hpp"
+#include "Node.hpp"
+#include <memory>
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace eSGraph;
+
+namespace {
+
+void EXPECT_VEC3_NEAR(const glm::vec3& a, const glm::vec3& b, float eps = 1e-5f) {
+    EXPECT_NEAR(a.x, b.x, eps);
+    EXPECT_NEAR(a.y, b.y, eps);
+    EXPECT_NEAR(a.z, b.z, eps);
+}
+
+void EXPECT_MAT4_NEAR(const glm::mat4& a, const glm::mat4& b, float eps = 1e-5f) {
+    for (int column = 0; column < 4; ++column) {
+        for (int row = 0; row < 4; ++row) {
+            EXPECT_NEAR(a[column][row], b[column][row], eps);
+        }
+    }
+}
+
+std::unique_ptr<Node> buildPrefab()
+{
+    auto root = std::make_unique<Node>("PREFAB");
+    auto body = std::make_unique<Node>("BODY");
+    auto turret = std::make_unique<Node>("TURRET");
+    auto barrel = std::make_unique<Node>("BARREL");
+    auto wheel = std::make_unique<Node>("WHEEL");
+
+    root->setPosition(glm::vec3(100.0f, 0.0f, 0.0f));
+    body->setPosition(glm::vec3(0.0f, 1.0f, 0.0f));
+    turret->setPosition(glm::vec3(0.0f, 0.5f, 0.0f));
+    turret->setRotation(glm::vec3(0.0f, 1.0f, 0.0f), glm::radians(90.0f));
+    barrel->setPosition(glm::vec3(0.0f, 0.0f, -2.0f));
+    barrel->setScale(glm::vec3(1.0f, 1.0f, 3.0f));
+    wheel->setPosition(glm::vec3(1.0f, -1.0f, 0.0f));
+
+    turret->addChild(std::move(barrel));
+    body->addChild(std::move(turret));
+    body->addChild(std::move(wheel));
+    root->addChild(std::move(body));
+    return root;
+}
+
+}
+
+void InstanceSetTests::SetUp()
+{
+}
+
+void InstanceSetTests::TearDown()
+{
+}
+
+TEST_F(InstanceSetTests, checkPrototypeFlattening)
+{
+    auto prefab = buildPrefab();
+    Prototype prototype(*prefab);
+
+    ASSERT_EQ(prototype.size(), 5u);
+    EXPECT_EQ(prototype.getIdentifier(0), "PREFAB");
+    EXPECT_EQ(prototype.getIdentifier(1), "BODY");
+    EXPECT_EQ(prototype.getIdentifier(2), "TURRET");
+    EXPECT_EQ(prototype.getIdentifier(3), "BARREL");
+    EXPECT_EQ(prototype.getIdentifier(4), "WHEEL");
+    EXPECT_EQ(prototype.getParentIndex(0), Prototype::NO_PARENT);
+    EXPECT_EQ(prototype.getParentIndex(3), 2u);
+    EXPECT_EQ(prototype.getParentIndex(4), 1u);
+    EXPECT_EQ(prototype.find("BARREL"), 3u);
+    EXPECT_EQ(prototype.find("MISSING"), Prototype::NOT_FOUND);
+    EXPECT_MAT4_NEAR(prototype.getModelMatrices()[0], glm::identity<glm::mat4>());
+}
+
+TEST_F(InstanceSetTests, checkGlobalMatricesMatchNodes)
+{
+    auto prefab = buildPrefab();
+    InstanceSet instances(std::make_shared<Prototype>(*prefab));
+
+    glm::quat rotation = glm::angleAxis(glm::radians(30.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    size_t index = instances.spawn(glm::vec3(5.0f, 6.0f, 7.0f), rotation, glm::vec3(2.0f));
+
+    prefab->setPosition(glm::vec3(5.0f, 6.0f, 7.0f));
+    prefab->setRotation(rotation);
+    prefab->setScale(2.0f);
+
+    std::vector<glm::mat4> matrices(instances.getPrototype().size());
+    instances.computeGlobalMatrices(index, matrices);
+
+    EXPECT_MAT4_NEAR(matrices[0], prefab->getGlobalMatrix());
+    EXPECT_MAT4_NEAR(matrices[3], prefab->findByIdentifier("BARREL")->getGlobalMatrix());
+    EXPECT_MAT4_NEAR(matrices[4], prefab->findByIdentifier("WHEEL")->getGlobalMatrix());
+    EXPECT_MAT4_NEAR(instances.getGlobalMatrix(index, 2), prefab->findByIdentifier("TURRET")->getGlobalMatrix());
+}
+
+TEST_F(InstanceSetTests, checkCopyOnWriteEdits)
+{
+    auto prefab = buildPrefab();
+    InstanceSet instances(std::make_shared<Prototype>(*prefab));
+
+    for (int i = 0; i < 100; ++i)
+    {
+        instances.spawn(glm::vec3(static_cast<float>(i), 0.0f, 0.0f));
+    }
+    EXPECT_EQ(instances.size(), 100u);
+    EXPECT_EQ(instances.getEditedCount(), 0u);
+
+    const size_t wheel = instances.getPrototype().find("WHEEL");
+    instances.setLocalPosition(42, wheel, glm::vec3(0.0f, 0.0f, 9.0f));
+
+    EXPECT_EQ(instances.getEditedCount(), 1u);
+    EXPECT_TRUE(instances.isEdited(42));
+    EXPECT_FALSE(instances.isEdited(41));
+    EXPECT_VEC3_NEAR(instances.getLocalPosition(41, wheel), glm::vec3(1.0f, -1.0f, 0.0f));
+    EXPECT_VEC3_NEAR(glm::vec3(instances.getGlobalMatrix(42, wheel)[3]), glm::vec3(42.0f, 1.0f, 9.0f));
+    EXPECT_VEC3_NEAR(glm::vec3(instances.getGlobalMatrix(41, wheel)[3]), glm::vec3(42.0f, 0.0f, 0.0f));
+
+    instances.revert(42);
+    EXPECT_EQ(instances.getEditedCount(), 0u);
+    EXPECT_VEC3_NEAR(glm::vec3(instances.getGlobalMatrix(42, wheel)[3]), glm::vec3(43.0f, 0.0f, 0.0f));
+}
+
+TEST_F(InstanceSetTests, checkDespawnKeepsEdits)
+{
+    auto prefab = buildPrefab();
+    InstanceSet instances(std::make_shared<Prototype>(*prefab));
+
+    instances.spawn(glm::vec3(0.0f));
+    instances.spawn(glm::vec3(1.0f));
+    instances.spawn(glm::vec3(2.0f));
+    instances.setLocalScale(0, 1, glm::vec3(4.0f));
+    instances.setLocalScale(2, 1, glm::vec3(5.0f));
+
+    instances.despawn(0);
+
+    EXPECT_EQ(instances.size(), 2u);
+    EXPECT_EQ(instances.getEditedCount(), 1u);
+    EXPECT_VEC3_NEAR(instances.getPosition(0), glm::vec3(2.0f));
+    EXPECT_VEC3_NEAR(instances.getLocalScale(0, 1), glm::vec3(5.0f));
+    EXPECT_FALSE(instances.isEdited(1));
+
+    std::vector<glm::mat4> all(instances.size() * instances.getPrototype().size());
+    instances.computeAllGlobalMatrices(all);
+    EXPECT_VEC3_NEAR(glm::vec3(all[0][3]), glm::vec3(2.0f));
+    EXPECT_VEC3_NEAR(glm::vec3(all[instances.getPrototype().size()][3]), glm::vec3(1.0f));
+}
+
+TEST_F(InstanceSetTests, checkInstantiate)
+{
+    auto prefab = buildPrefab();
+    InstanceSet instances(std::make_shared<Prototype>(*prefab));
+
+    size_t index = instances.spawn(glm::vec3(0.0f, 0.0f, 10.0f));
+    instances.setLocalRotation(index, 2, glm::identity<glm::quat>());
+
+    auto node = instances.instantiate(index);
+
+    ASSERT_NE(node, nullptr);
+    EXPECT_EQ(node->getIdentifier(), "PREFAB");
+    Node* barrel = node->findByIdentifier("BARREL");
+    ASSERT_NE(barrel, nullptr);
+    EXPECT_EQ(barrel->getParent()->getIdentifier(), "TURRET");
+    EXPECT_VEC3_NEAR(barrel->getPosition(Coordinates::WORLD), glm::vec3(0.0f, 1.5f, 8.0f));
+    EXPECT_VEC3_NEAR(glm::vec3(instances.getGlobalMatrix(index, 3)[3]), glm::vec3(0.0f, 1.5f, 8.0f));
+}
@@ -0,0 +1,84 @@
+//
+//  InterpolationBufferTests.cpp
+//  eSGraph
+//
+
+#include "InterpolationBufferTests.hpp"
+#include "InterpolationBuffer.hpp"
+#include "Node.hpp"
+#include <cmath>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace eSGraph;
+
+void InterpolationBufferTests::SetUp()
+{
+}
+
+void InterpolationBufferTests::TearDown()
+{
+}
+
+TEST_F(InterpolationBufferTests, checkBlendBetweenTicks)
+{
+    auto root = std::make_unique<Node>("ROOT");
+    auto arm = std::make_unique<Node>("ARM");
+    arm->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    Node* armPtr = arm.get();
+    root->addChild(std::move(arm));
+
+    InterpolationBuffer buffer(*root);
+    ASSERT_EQ(buffer.size(), 2u);
+    EXPECT_EQ(buffer.getNode(1), armPtr);
+
+    // Tick: root moves and turns 90 degrees around Z
+    root->setPosition(glm::vec3(10.0f, 0.0f, 0.0f));
+    root->setRotation(glm::angleAxis(glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f)));
+    buffer.capture();
+
+    std::vector<glm::mat4> world(buffer.size());
+    buffer.interpolate(0.0f, world);
+    EXPECT_NEAR(world[1][3][0], 1.0f, 1e-5f);
+    EXPECT_NEAR(world[1][3][1], 0.0f, 1e-5f);
+
+    buffer.interpolate(0.5f, world);
+    EXPECT_NEAR(world[0][3][0], 5.0f, 1e-5f);
+    // Halfway through the turn the arm points along the XY diagonal
+    EXPECT_NEAR(world[1][3][0], 5.0f + std::sqrt(0.5f), 1e-5f);
+    EXPECT_NEAR(world[1][3][1], std::sqrt(0.5f), 1e-5f);
+
+    buffer.interpolate(1.0f, world);
+    const glm::mat4& expected = armPtr->getGlobalMatrix();
+    for (int column = 0; column < 4; ++column)
+    {
+        for (int row = 0; row < 4; ++row)
+        {
+            EXPECT_NEAR(world[1][column][row], expected[column][row], 1e-5f);
+        }
+    }
+}
+
+TEST_F(InterpolationBufferTests, checkInterpolationLeavesNodesUntouched)
+{
+    auto parent = std::make_unique<Node>("PARENT");
+    parent->setPosition(glm::vec3(0.0f, 100.0f, 0.0f));
+    auto child = std::make_unique<Node>("CHILD");
+    Node* childPtr = child.get();
+    parent->addChild(std::move(child));
+
+    InterpolationBuffer buffer(*childPtr);
+    childPtr->setPosition(glm::vec3(2.0f, 0.0f, 0.0f));
+    buffer.capture();
+
+    const std::uint32_t version = childPtr->getGlobalMatrixVersion();
+    std::vector<glm::mat4> world(1);
+    buffer.interpolate(0.25f, world);
+
+    // Placed under the parent's world matrix; the child's cache was not refreshed
+    EXPECT_NEAR(world[0][3][0], 0.5f, 1e-5f);
+    EXPECT_NEAR(world[0][3][1], 100.0f, 1e-5f);
+    EXPECT_EQ(childPtr->getGlobalMatrixVersion(), version);
+    EXPECT_NEAR(childPtr->getPosition().x, 2.0f, 1e-6f);
+}
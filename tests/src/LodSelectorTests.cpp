@@ -0,0 +1,133 @@
+//
+//  LodSelectorTests.cpp
+//  eSGraph
+//
+
+#include "LodSelectorTests.hpp"
+#include "LodSelector.hpp"
+#include "Node.hpp"
+#include <array>
+#include <memory>
+#include <gtest/gtest.h>
+
+using namespace eSGraph;
+
+void LodSelectorTests::SetUp()
+{
+}
+
+void LodSelectorTests::TearDown()
+{
+}
+
+TEST_F(LodSelectorTests, checkSelectByDistance)
+{
+    auto root = std::make_unique<Node>("ROOT");
+    auto camera = std::make_unique<Node>("CAMERA");
+    auto nearNode = std::make_unique<Node>("NEAR");
+    auto farNode = std::make_unique<Node>("FAR");
+    auto outsideNode = std::make_unique<Node>("OUTSIDE");
+
+    nearNode->setPosition(glm::vec3(5.0f, 0.0f, 0.0f));
+    farNode->setPosition(glm::vec3(0.0f, 0.0f, -50.0f));
+    outsideNode->setPosition(glm::vec3(0.0f, 500.0f, 0.0f));
+
+    Node* nearPtr = nearNode.get();
+    Node* farPtr = farNode.get();
+    Node* outsidePtr = outsideNode.get();
+    Node* cameraPtr = camera.get();
+    root->addChild(std::move(camera));
+    root->addChild(std::move(nearNode));
+    root->addChild(std::move(farNode));
+    root->addChild(std::move(outsideNode));
+
+    const std::array<float, 2> distances{10.0f, 100.0f};
+    LodSelector selector(0.0f);
+    selector.addNode(nearPtr, distances);
+    selector.addNode(farPtr, distances);
+    selector.addNode(outsidePtr, distances);
+
+    auto lods = selector.select(*cameraPtr);
+
+    ASSERT_EQ(lods.size(), 3u);
+    EXPECT_EQ(lods[0], 0);
+    EXPECT_EQ(lods[1], 1);
+    EXPECT_EQ(lods[2], 2);
+    EXPECT_FLOAT_EQ(selector.getSquaredDistances()[0], 25.0f);
+    EXPECT_FLOAT_EQ(selector.getSquaredDistances()[1], 2500.0f);
+}
+
+TEST_F(LodSelectorTests, checkCameraInHierarchy)
+{
+    auto root = std::make_unique<Node>("ROOT");
+    auto rig = std::make_unique<Node>("RIG");
+    auto camera = std::make_unique<Node>("CAMERA");
+    auto target = std::make_unique<Node>("TARGET");
+
+    rig->setPosition(glm::vec3(100.0f, 0.0f, 0.0f));
+    camera->setPosition(glm::vec3(0.0f, 0.0f, 10.0f));
+    target->setPosition(glm::vec3(100.0f, 0.0f, 0.0f));
+
+    // The target lives in its own hierarchy, so moving the camera's ancestors changes
+    // the distance
+    Node* cameraPtr = camera.get();
+    Node* targetPtr = target.get();
+    rig->addChild(std::move(camera));
+    root->addChild(std::move(rig));
+
+    const std::array<float, 1> distances{20.0f};
+    LodSelector selector(0.0f);
+    selector.addNode(targetPtr, distances);
+
+    EXPECT_EQ(selector.select(*cameraPtr)[0], 0);
+    EXPECT_FLOAT_EQ(selector.getSquaredDistances()[0], 100.0f);
+
+    // Camera world position is root + rig + camera = (100, 0, 50 + 30 + 10)
+    root->setPosition(glm::vec3(0.0f, 0.0f, 50.0f));
+    cameraPtr->getParent()->translate(glm::vec3(0.0f, 0.0f, 30.0f));
+
+    EXPECT_EQ(selector.select(*cameraPtr)[0], 1);
+    EXPECT_FLOAT_EQ(selector.getSquaredDistances()[0], 8100.0f);
+
+    // Moving only the root brings the camera back within the switch distance
+    root->setPosition(glm::vec3(0.0f, 0.0f, -35.0f));
+    EXPECT_EQ(selector.select(*cameraPtr)[0], 0);
+    EXPECT_FLOAT_EQ(selector.getSquaredDistances()[0], 25.0f);
+}
+
+TEST_F(LodSelectorTests, checkHysteresis)
+{
+    auto camera = std::make_unique<Node>("CAMERA");
+    auto node = std::make_unique<Node>("NODE");
+
+    const std::array<float, 1> distances{10.0f};
+    LodSelector selector(0.1f);
+    selector.addNode(node.get(), distances);
+
+    node->setPosition(glm::vec3(10.5f, 0.0f, 0.0f));
+    EXPECT_EQ(selector.select(*camera)[0], 0);  // Inside the dead band, stays at 0
+
+    node->setPosition(glm::vec3(11.5f, 0.0f, 0.0f));
+    EXPECT_EQ(selector.select(*camera)[0], 1);
+
+    node->setPosition(glm::vec3(9.5f, 0.0f, 0.0f));
+    EXPECT_EQ(selector.select(*camera)[0], 1);  // Inside the dead band, stays at 1
+
+    node->setPosition(glm::vec3(8.5f, 0.0f, 0.0f));
+    EXPECT_EQ(selector.select(*camera)[0], 0);
+}
+
+TEST_F(LodSelectorTests, checkClear)
+{
+    auto camera = std::make_unique<Node>("CAMERA");
+    auto node = std::make_unique<Node>("NODE");
+
+    const std::array<float, 1> distances{10.0f};
+    LodSelector selector;
+    selector.addNode(node.get(), distances);
+    EXPECT_EQ(selector.size(), 1u);
+
+    selector.clear();
+    EXPECT_EQ(selector.size(), 0u);
+    EXPECT_TRUE(selector.select(*camera).empty());
+}
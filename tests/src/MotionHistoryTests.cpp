@@ -0,0 +1,126 @@
+//
+//  MotionHistoryTests.cpp
+//  eSGraph
+//
+
+#include "MotionHistoryTests.hpp"
+#include "MotionHistory.hpp"
+#include "ConstraintStage.hpp"
+#include "Node.hpp"
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace eSGraph;
+
+namespace {
+
+std::unique_ptr<Node> makeScene()
+{
+    auto root = std::make_unique<Node>("ROOT");
+    auto car = std::make_unique<Node>("CAR");
+    car->addChild(std::make_unique<Node>("WHEEL"));
+    root->addChild(std::move(car));
+    root->addChild(std::make_unique<Node>("TREE"));
+    return root;
+}
+
+}
+
+void MotionHistoryTests::SetUp()
+{
+}
+
+void MotionHistoryTests::TearDown()
+{
+}
+
+TEST_F(MotionHistoryTests, checkPreviousFrameMatrix)
+{
+    auto root = makeScene();
+    MotionHistory history;
+    history.trackSubtree(*root);
+
+    Node* car = root->findByIdentifier("CAR");
+    const std::uint32_t wheel = 2;
+    ASSERT_EQ(history.getNode(wheel)->getIdentifier(), "WHEEL");
+
+    // Frame 1: the car moves, which invalidates the wheel too
+    car->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(history.getMovedCount(), 2u);
+    history.advanceFrame();
+    EXPECT_EQ(history.getMovedCount(), 0u);
+    EXPECT_NEAR(history.getMatrices(wheel).current[3][0], 1.0f, 1e-6f);
+    EXPECT_NEAR(history.getMatrices(wheel).previous[3][0], 0.0f, 1e-6f);
+
+    // Frame 2: moving again shifts the history by one frame
+    car->setPosition(glm::vec3(3.0f, 0.0f, 0.0f));
+    history.advanceFrame();
+    EXPECT_NEAR(history.getMatrices(wheel).current[3][0], 3.0f, 1e-6f);
+    EXPECT_NEAR(history.getMatrices(wheel).previous[3][0], 1.0f, 1e-6f);
+
+    // Frame 3: at rest, previous catches up with current
+    history.advanceFrame();
+    EXPECT_NEAR(history.getMatrices(wheel).previous[3][0], 3.0f, 1e-6f);
+}
+
+TEST_F(MotionHistoryTests, checkStaticNodesAreNotVisited)
+{
+    auto root = makeScene();
+    MotionHistory history;
+    history.trackSubtree(*root);
+
+    Node* tree = root->findByIdentifier("TREE");
+    tree->freeze();
+
+    root->setPosition(glm::vec3(0.0f, 5.0f, 0.0f));
+    // ROOT, CAR and WHEEL; the frozen TREE is skipped by the dirty walk
+    EXPECT_EQ(history.getMovedCount(), 3u);
+    history.advanceFrame();
+
+    const std::vector<std::uint32_t> visible = {3, 1};
+    std::vector<MotionMatrices> exported(visible.size());
+    history.exportMatrices(visible, exported);
+    EXPECT_NEAR(exported[0].current[3][1], 0.0f, 1e-6f);
+    EXPECT_NEAR(exported[0].previous[3][1], 0.0f, 1e-6f);
+    EXPECT_NEAR(exported[1].current[3][1], 5.0f, 1e-6f);
+    EXPECT_NEAR(exported[1].previous[3][1], 0.0f, 1e-6f);
+}
+
+TEST_F(MotionHistoryTests, checkDestroyedNodesAreIgnored)
+{
+    auto root = makeScene();
+    MotionHistory history;
+    history.trackSubtree(*root);
+
+    root->findByIdentifier("TREE")->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    auto removed = root->removeChild(root->findByIdentifier("TREE"));
+    removed.reset();
+
+    EXPECT_EQ(history.getNode(3), nullptr);
+    history.advanceFrame();
+    EXPECT_EQ(history.getMovedCount(), 0u);
+}
+
+TEST_F(MotionHistoryTests, checkConstraintOverridesAreRecorded)
+{
+    auto root = makeScene();
+    Node* car = root->findByIdentifier("CAR");
+    Node* tree = root->findByIdentifier("TREE");
+    MotionHistory history;
+    const std::uint32_t first = history.trackSubtree(*car);
+
+    ConstraintStage stage;
+    stage.addPositionConstraint(car, tree);
+    stage.evaluate();
+    history.advanceFrame();
+
+    // The constrained car follows the tree without its local transform changing
+    tree->setPosition(glm::vec3(10.0f, 0.0f, 0.0f));
+    stage.evaluate();
+    EXPECT_EQ(history.getMovedCount(), 2u);
+    history.advanceFrame();
+    EXPECT_NEAR(history.getMatrices(first).current[3][0], 10.0f, 1e-6f);
+    EXPECT_NEAR(history.getMatrices(first).previous[3][0], 0.0f, 1e-6f);
+    EXPECT_NEAR(history.getMatrices(first + 1).current[3][0], 10.0f, 1e-6f);
+}
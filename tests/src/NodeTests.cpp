@@ -1107,6 +1107,23 @@ TEST_F(NodeTests, checkLookAtOffAxis)
     EXPECT_VEC3_NEAR(forward, glm::vec3(1.0f, 0.0f, 0.0f));
 }
 
+TEST_F(NodeTests, checkWorldRotationFollowsParentAfterRotationOnlyRead)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto child = std::make_unique<Node>("CHILD");
+    Node* childPtr = child.get();
+    root->addChild(std::move(child));
+
+    // Reading only the world rotation leaves the world matrix dirty
+    (void)childPtr->getRotation(Coordinates::WORLD);
+
+    const glm::quat rotation = glm::angleAxis(1.0f, glm::vec3(0.0f, 1.0f, 0.0f));
+    root->setRotation(rotation);
+
+    EXPECT_NEAR(std::abs(glm::dot(childPtr->getRotation(Coordinates::WORLD), rotation)), 1.0f, 1e-5f);
+    EXPECT_VEC3_NEAR(childPtr->getForward(), rotation * glm::vec3(0.0f, 0.0f, -1.0f), 1e-5f);
+}
+
 // === Clone Tests ===
 
 TEST_F(NodeTests, checkCloneSimple)
@@ -1159,3 +1176,939 @@ TEST_F(NodeTests, checkCloneIndependence)
     EXPECT_VEC3_NEAR(cloned->getPosition(), glm::vec3(1.0f, 2.0f, 3.0f));
     EXPECT_VEC3_NEAR(original->getPosition(), glm::vec3(10.0f, 20.0f, 30.0f));
 }
+
+TEST_F(NodeTests, checkClonePreservesStructure)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    for (int i = 0; i < 3; ++i)
+    {
+        auto child = std::make_unique<Node>("CHILD_" + std::to_string(i));
+        child->setPosition(glm::vec3(static_cast<float>(i), 0.0f, 0.0f));
+        child->addChild(std::make_unique<Node>("LEAF_" + std::to_string(i)));
+        root->addChild(std::move(child));
+    }
+    root->setRotation(glm::vec3(0.0f, 0.0f, 1.0f), glm::radians(90.0f));
+
+    auto cloned = root->clone();
+
+    ASSERT_EQ(cloned->getChildren().size(), 3u);
+    for (int i = 0; i < 3; ++i)
+    {
+        Node* child = cloned->getChildren()[i].get();
+        EXPECT_EQ(child->getIdentifier(), "CHILD_" + std::to_string(i));
+        EXPECT_EQ(child->getParent(), cloned.get());
+        ASSERT_EQ(child->getChildren().size(), 1u);
+        EXPECT_EQ(child->getChildren().front()->getParent(), child);
+
+        Node* original = root->getChildren()[i].get();
+        EXPECT_VEC3_NEAR(child->getPosition(Coordinates::WORLD), original->getPosition(Coordinates::WORLD));
+    }
+}
+
+TEST_F(NodeTests, checkCloneDetachedFromParent)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto child = std::make_unique<Node>("CHILD");
+    child->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    Node* childPtr = child.get();
+    root->addChild(std::move(child));
+    root->setPosition(glm::vec3(10.0f, 0.0f, 0.0f));
+    (void)childPtr->getGlobalMatrix();
+
+    auto cloned = childPtr->clone();
+
+    EXPECT_FALSE(cloned->hasParent());
+    EXPECT_VEC3_NEAR(glm::vec3(cloned->getGlobalMatrix()[3]), glm::vec3(1.0f, 0.0f, 0.0f));
+}
+
+TEST_F(NodeTests, checkCloneVeryDeepHierarchy)
+{
+    const int depth = 5000;
+    std::unique_ptr<Node> root = std::make_unique<Node>("NODE_0");
+    Node* current = root.get();
+    for (int i = 1; i < depth; ++i)
+    {
+        auto child = std::make_unique<Node>("NODE_" + std::to_string(i));
+        child->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+        Node* next = child.get();
+        current->addChild(std::move(child));
+        current = next;
+    }
+
+    auto cloned = root->clone();
+
+    Node* deepest = cloned.get();
+    while (deepest->hasChildren())
+    {
+        deepest = deepest->getChildren().front().get();
+    }
+    EXPECT_EQ(deepest->getIdentifier(), "NODE_" + std::to_string(depth - 1));
+    EXPECT_EQ(deepest->getDepth(), static_cast<size_t>(depth - 1));
+}
+
+TEST_F(NodeTests, checkCloneMany)
+{
+    std::unique_ptr<Node> prefab = std::make_unique<Node>("PREFAB");
+    prefab->addChild(std::make_unique<Node>("PART"));
+    prefab->setScale(3.0f);
+
+    auto clones = prefab->clone(4);
+
+    ASSERT_EQ(clones.size(), 4u);
+    EXPECT_NE(clones[0].get(), clones[1].get());
+    for (const auto& cloned : clones)
+    {
+        EXPECT_EQ(cloned->getIdentifier(), "PREFAB");
+        EXPECT_VEC3_NEAR(cloned->getScale(), glm::vec3(3.0f));
+        EXPECT_NE(cloned->findByIdentifier("PART"), nullptr);
+    }
+}
+
+// === Static Subtree Tests ===
+
+TEST_F(NodeTests, checkFreezeIgnoresAncestorChanges)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto cell = std::make_unique<Node>("CELL");
+    auto prop = std::make_unique<Node>("PROP");
+
+    prop->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    Node* cellPtr = cell.get();
+    Node* propPtr = prop.get();
+    cell->addChild(std::move(prop));
+    root->addChild(std::move(cell));
+
+    cellPtr->freeze();
+    EXPECT_TRUE(cellPtr->isStatic());
+    EXPECT_TRUE(propPtr->isStatic());
+    EXPECT_FALSE(root->isStatic());
+
+    root->setPosition(glm::vec3(10.0f, 0.0f, 0.0f));
+    root->setRotation(glm::vec3(0.0f, 1.0f, 0.0f), glm::radians(90.0f));
+
+    EXPECT_VEC3_NEAR(propPtr->getPosition(Coordinates::WORLD), glm::vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_VEC3_NEAR(glm::vec3(propPtr->getGlobalMatrix()[3]), glm::vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_QUAT_NEAR(propPtr->getRotation(Coordinates::WORLD), glm::identity<glm::quat>());
+}
+
+TEST_F(NodeTests, checkUnfreezeRebakes)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto prop = std::make_unique<Node>("PROP");
+    prop->setPosition(glm::vec3(0.0f, 2.0f, 0.0f));
+    Node* propPtr = prop.get();
+    root->addChild(std::move(prop));
+
+    root->freeze();
+    root->setPosition(glm::vec3(5.0f, 0.0f, 0.0f));
+    propPtr->setPosition(glm::vec3(0.0f, 3.0f, 0.0f));
+
+    EXPECT_VEC3_NEAR(glm::vec3(propPtr->getGlobalMatrix()[3]), glm::vec3(0.0f, 2.0f, 0.0f));
+
+    root->unfreeze();
+    EXPECT_FALSE(root->isStatic());
+    EXPECT_FALSE(propPtr->isStatic());
+    EXPECT_VEC3_NEAR(glm::vec3(propPtr->getGlobalMatrix()[3]), glm::vec3(5.0f, 3.0f, 0.0f));
+}
+
+TEST_F(NodeTests, checkFreezeCollectsBakedMatrices)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto first = std::make_unique<Node>("FIRST");
+    auto second = std::make_unique<Node>("SECOND");
+    auto grandChild = std::make_unique<Node>("GRANDCHILD");
+
+    root->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    first->setPosition(glm::vec3(0.0f, 1.0f, 0.0f));
+    second->setPosition(glm::vec3(0.0f, 0.0f, 1.0f));
+    grandChild->setPosition(glm::vec3(0.0f, 1.0f, 0.0f));
+    first->addChild(std::move(grandChild));
+    root->addChild(std::move(first));
+    root->addChild(std::move(second));
+
+    std::vector<glm::mat4> baked;
+    root->freeze(&baked);
+
+    ASSERT_EQ(baked.size(), 4u);
+    EXPECT_VEC3_NEAR(glm::vec3(baked[0][3]), glm::vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_VEC3_NEAR(glm::vec3(baked[1][3]), glm::vec3(1.0f, 1.0f, 0.0f));
+    EXPECT_VEC3_NEAR(glm::vec3(baked[2][3]), glm::vec3(1.0f, 2.0f, 0.0f));
+    EXPECT_VEC3_NEAR(glm::vec3(baked[3][3]), glm::vec3(1.0f, 0.0f, 1.0f));
+}
+
+// === Global Matrix Version Tests ===
+
+TEST_F(NodeTests, checkGlobalMatrixVersionTracksRecomputation)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto child = std::make_unique<Node>("CHILD");
+    Node* childPtr = child.get();
+    root->addChild(std::move(child));
+
+    (void)childPtr->getGlobalMatrix();
+    const std::uint32_t version = childPtr->getGlobalMatrixVersion();
+
+    // Clean reads do not recompute
+    (void)childPtr->getGlobalMatrix();
+    EXPECT_EQ(childPtr->getGlobalMatrixVersion(), version);
+
+    // An ancestor change recomputes on the next read
+    root->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(childPtr->getGlobalMatrixVersion(), version);
+    (void)childPtr->getGlobalMatrix();
+    EXPECT_EQ(childPtr->getGlobalMatrixVersion(), version + 1);
+}
+
+// === Transform Inheritance Tests ===
+
+TEST_F(NodeTests, checkInheritanceDefaultsToAll)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto child = std::make_unique<Node>("CHILD");
+    Node* childPtr = child.get();
+    root->addChild(std::move(child));
+
+    EXPECT_EQ(childPtr->getInheritance(), TransformInheritance::ALL);
+
+    root->setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    root->setRotation(glm::angleAxis(glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+    childPtr->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    const glm::mat4 expected = root->getGlobalMatrix() * childPtr->getMatrix();
+    EXPECT_VEC3_NEAR(glm::vec3(childPtr->getGlobalMatrix()[3]), glm::vec3(expected[3]), 1e-5f);
+}
+
+TEST_F(NodeTests, checkTranslationOnlyInheritance)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto child = std::make_unique<Node>("CHILD");
+    Node* childPtr = child.get();
+    root->addChild(std::move(child));
+
+    root->setPosition(glm::vec3(10.0f, 0.0f, 0.0f));
+    root->setRotation(glm::angleAxis(glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+    root->setScale(glm::vec3(2.0f));
+    childPtr->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    childPtr->setInheritance(TransformInheritance::TRANSLATION);
+
+    // Follows the parent position, ignores its rotation and scale
+    EXPECT_VEC3_NEAR(childPtr->getPosition(Coordinates::WORLD), glm::vec3(11.0f, 0.0f, 0.0f), 1e-5f);
+    EXPECT_VEC3_NEAR(glm::vec3(childPtr->getGlobalMatrix()[0]), glm::vec3(1.0f, 0.0f, 0.0f), 1e-5f);
+    const glm::quat worldRotation = childPtr->getRotation(Coordinates::WORLD);
+    EXPECT_NEAR(std::abs(worldRotation.w), 1.0f, 1e-5f);
+}
+
+TEST_F(NodeTests, checkRotationWithoutScaleInheritance)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto child = std::make_unique<Node>("CHILD");
+    Node* childPtr = child.get();
+    root->addChild(std::move(child));
+
+    const glm::quat parentRotation = glm::angleAxis(glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    root->setRotation(parentRotation);
+    root->setScale(glm::vec3(3.0f));
+    childPtr->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    childPtr->setInheritance(TransformInheritance::TRANSLATION | TransformInheritance::ROTATION);
+
+    // Rotated by the parent but not scaled: +X becomes +Y at unit distance
+    EXPECT_VEC3_NEAR(childPtr->getPosition(Coordinates::WORLD), glm::vec3(0.0f, 1.0f, 0.0f), 1e-5f);
+    EXPECT_NEAR(glm::length(glm::vec3(childPtr->getGlobalMatrix()[0])), 1.0f, 1e-5f);
+    EXPECT_NEAR(std::abs(glm::dot(childPtr->getRotation(Coordinates::WORLD), parentRotation)), 1.0f, 1e-5f);
+}
+
+TEST_F(NodeTests, checkWorldSettersHonorInheritance)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto child = std::make_unique<Node>("CHILD");
+    Node* childPtr = child.get();
+    root->addChild(std::move(child));
+
+    root->setPosition(glm::vec3(5.0f, 0.0f, 0.0f));
+    root->setRotation(glm::angleAxis(glm::radians(45.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+    root->setScale(glm::vec3(2.0f));
+    childPtr->setInheritance(TransformInheritance::TRANSLATION | TransformInheritance::SCALE);
+
+    const glm::vec3 worldPosition(7.0f, 4.0f, -2.0f);
+    const glm::quat worldRotation = glm::angleAxis(glm::radians(30.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    childPtr->setPosition(worldPosition, Coordinates::WORLD);
+    childPtr->setRotation(worldRotation, Coordinates::WORLD);
+
+    EXPECT_VEC3_NEAR(childPtr->getPosition(Coordinates::WORLD), worldPosition, 1e-4f);
+    EXPECT_VEC3_NEAR(glm::vec3(childPtr->getGlobalMatrix()[3]), worldPosition, 1e-4f);
+    EXPECT_NEAR(std::abs(glm::dot(childPtr->getRotation(Coordinates::WORLD), worldRotation)), 1.0f, 1e-5f);
+}
+
+TEST_F(NodeTests, checkSetInheritanceInvalidatesSubtree)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto child = std::make_unique<Node>("CHILD");
+    auto grandchild = std::make_unique<Node>("GRANDCHILD");
+    Node* childPtr = child.get();
+    Node* grandchildPtr = grandchild.get();
+    child->addChild(std::move(grandchild));
+    root->addChild(std::move(child));
+
+    root->setPosition(glm::vec3(0.0f, 3.0f, 0.0f));
+    grandchildPtr->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_VEC3_NEAR(grandchildPtr->getPosition(Coordinates::WORLD), glm::vec3(1.0f, 3.0f, 0.0f), 1e-5f);
+
+    childPtr->setInheritance(TransformInheritance::NONE);
+    EXPECT_VEC3_NEAR(grandchildPtr->getPosition(Coordinates::WORLD), glm::vec3(1.0f, 0.0f, 0.0f), 1e-5f);
+
+    // Clones keep the flags
+    std::unique_ptr<Node> copy = root->clone();
+    const Node* copiedChild = copy->getChildren().front().get();
+    EXPECT_EQ(copiedChild->getInheritance(), TransformInheritance::NONE);
+}
+
+// === Floating Origin Tests ===
+
+TEST_F(NodeTests, checkRebaseOriginShiftsWorldQueries)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto child = std::make_unique<Node>("CHILD");
+    Node* childPtr = child.get();
+    root->addChild(std::move(child));
+
+    root->setPosition(glm::vec3(100000.0f, 0.0f, 0.0f));
+    childPtr->setPosition(glm::vec3(0.25f, 0.0f, 0.0f));
+    (void)childPtr->getGlobalMatrix();
+
+    Node* roots[] = {root.get()};
+    Node::rebaseOrigin(roots, glm::dvec3(100000.0, 0.0, 0.0));
+
+    EXPECT_EQ(root->getOrigin(), glm::dvec3(100000.0, 0.0, 0.0));
+    EXPECT_VEC3_NEAR(root->getPosition(Coordinates::WORLD), glm::vec3(0.0f));
+    EXPECT_VEC3_NEAR(childPtr->getPosition(Coordinates::WORLD), glm::vec3(0.25f, 0.0f, 0.0f));
+    EXPECT_VEC3_NEAR(glm::vec3(childPtr->getGlobalMatrix()[3]), glm::vec3(0.25f, 0.0f, 0.0f));
+
+    // Local transforms are untouched by a rebase
+    EXPECT_VEC3_NEAR(root->getPosition(), glm::vec3(100000.0f, 0.0f, 0.0f));
+}
+
+TEST_F(NodeTests, checkRebaseOriginKeepsPrecisionFarFromZero)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    root->setPosition(glm::vec3(150000.0f, 0.0f, 0.0f));
+
+    // A float at 150 km has a spacing of ~16 mm, well above this offset
+    root->setOrigin(glm::dvec3(149999.99, 0.0, 0.0));
+    const float x = root->getGlobalMatrix()[3].x;
+    EXPECT_NEAR(x, 0.01f, 1e-3f);
+}
+
+TEST_F(NodeTests, checkWorldSettersAreRelativeToOrigin)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto child = std::make_unique<Node>("CHILD");
+    Node* childPtr = child.get();
+    root->addChild(std::move(child));
+
+    root->setOrigin(glm::dvec3(0.0, 0.0, 5000.0));
+    root->setPosition(glm::vec3(1.0f, 2.0f, 3.0f), Coordinates::WORLD);
+    EXPECT_VEC3_NEAR(root->getPosition(), glm::vec3(1.0f, 2.0f, 5003.0f));
+
+    childPtr->setPosition(glm::vec3(0.0f, 0.0f, 1.0f), Coordinates::WORLD);
+    EXPECT_VEC3_NEAR(childPtr->getPosition(), glm::vec3(-1.0f, -2.0f, -2.0f), 1e-3f);
+
+    // Nodes that drop the parent translation still live in origin-relative space
+    childPtr->setInheritance(TransformInheritance::ROTATION);
+    childPtr->setPosition(glm::vec3(0.0f, 0.0f, 5001.0f));
+    EXPECT_VEC3_NEAR(childPtr->getPosition(Coordinates::WORLD), glm::vec3(0.0f, 0.0f, 1.0f), 1e-3f);
+}
+
+TEST_F(NodeTests, checkRebaseOriginShiftsFrozenSubtrees)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto child = std::make_unique<Node>("CHILD");
+    Node* childPtr = child.get();
+    root->addChild(std::move(child));
+    childPtr->setPosition(glm::vec3(0.0f, 1.0f, 0.0f));
+    root->freeze();
+
+    const std::uint32_t version = childPtr->getGlobalMatrixVersion();
+    Node* roots[] = {root.get()};
+    Node::rebaseOrigin(roots, glm::dvec3(0.0, 10.0, 0.0));
+
+    EXPECT_VEC3_NEAR(glm::vec3(childPtr->getGlobalMatrix()[3]), glm::vec3(0.0f, -9.0f, 0.0f));
+    EXPECT_EQ(childPtr->getGlobalMatrixVersion(), version + 1);
+    EXPECT_TRUE(childPtr->isStatic());
+}
+
+TEST_F(NodeTests, checkRebaseOriginKeepsFrozenNodesBaked)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto child = std::make_unique<Node>("CHILD");
+    Node* childPtr = child.get();
+    root->addChild(std::move(child));
+    childPtr->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    childPtr->freeze();
+
+    // The frozen child ignores its parent moving
+    root->setPosition(glm::vec3(100.0f, 0.0f, 0.0f));
+    EXPECT_NEAR(childPtr->getGlobalMatrix()[3].x, 1.0f, 1e-5f);
+
+    // Rebasing an unrelated hierarchy leaves it alone
+    std::unique_ptr<Node> other = std::make_unique<Node>("OTHER");
+    const std::uint32_t version = childPtr->getGlobalMatrixVersion();
+    Node* otherRoots[] = {other.get()};
+    Node::rebaseOrigin(otherRoots, glm::dvec3(50.0, 0.0, 0.0));
+    EXPECT_NEAR(childPtr->getGlobalMatrix()[3].x, 1.0f, 1e-5f);
+    EXPECT_EQ(childPtr->getGlobalMatrixVersion(), version);
+    EXPECT_NEAR(other->getGlobalMatrix()[3].x, -50.0f, 1e-5f);
+
+    // Rebasing its own hierarchy shifts the baked translation, not the parent's
+    Node* roots[] = {root.get()};
+    Node::rebaseOrigin(roots, glm::dvec3(10.0, 0.0, 0.0));
+    EXPECT_NEAR(childPtr->getGlobalMatrix()[3].x, -9.0f, 1e-5f);
+    EXPECT_NEAR(root->getGlobalMatrix()[3].x, 90.0f, 1e-5f);
+}
+
+// === Precise World Position Tests ===
+
+TEST_F(NodeTests, checkPreciseWorldPositionAccumulatesInDouble)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto child = std::make_unique<Node>("CHILD");
+    Node* childPtr = child.get();
+    root->addChild(std::move(child));
+
+    root->setPosition(glm::vec3(6000000.0f, 0.0f, 0.0f));
+    root->setRotation(glm::angleAxis(glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f)));
+    childPtr->setPosition(glm::vec3(0.125f, 0.0f, 0.0f));
+
+    // Rotated by the parent: the offset lands on +Y without being rounded away
+    const glm::dvec3 precise = childPtr->getPreciseWorldPosition();
+    EXPECT_NEAR(precise.x, 6000000.0, 1e-6);
+    EXPECT_NEAR(precise.y, 0.125, 1e-6);
+
+    // Invalidated by ancestor changes like the world matrix
+    root->setPosition(glm::vec3(6000001.0f, 0.0f, 0.0f));
+    EXPECT_NEAR(childPtr->getPreciseWorldPosition().x, 6000001.0, 1e-6);
+}
+
+TEST_F(NodeTests, checkPreciseWorldPositionIgnoresOrigin)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    root->setPosition(glm::vec3(1000.0f, 0.0f, 0.0f));
+    root->setOrigin(glm::dvec3(900.0, 0.0, 0.0));
+
+    EXPECT_NEAR(root->getPreciseWorldPosition().x, 1000.0, 1e-9);
+    EXPECT_NEAR(root->getGlobalMatrix()[3].x, 100.0f, 1e-5f);
+}
+
+TEST_F(NodeTests, checkPreciseWorldPositionOfFrozenNodeIsBaked)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto child = std::make_unique<Node>("CHILD");
+    Node* childPtr = child.get();
+    root->addChild(std::move(child));
+    childPtr->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    childPtr->freeze();
+
+    // The parent moves after the bake; the frozen child stays where it was baked
+    root->setPosition(glm::vec3(100.0f, 0.0f, 0.0f));
+    EXPECT_NEAR(childPtr->getGlobalMatrix()[3].x, 1.0f, 1e-5f);
+    EXPECT_NEAR(childPtr->getPreciseWorldPosition().x, 1.0, 1e-9);
+
+    Node* nodes[] = {childPtr};
+    std::vector<glm::mat4> matrices(1);
+    Node::exportCameraRelativeMatrices(nodes, glm::dvec3(0.5, 0.0, 0.0), matrices);
+    EXPECT_VEC3_NEAR(glm::vec3(matrices[0][3]), glm::vec3(0.5f, 0.0f, 0.0f));
+}
+
+TEST_F(NodeTests, checkExportCameraRelativeMatrices)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto child = std::make_unique<Node>("CHILD");
+    Node* childPtr = child.get();
+    root->addChild(std::move(child));
+
+    root->setPosition(glm::vec3(8000000.0f, 0.0f, 0.0f));
+    root->setScale(2.0f);
+    childPtr->setPosition(glm::vec3(0.0f, 0.0f, 0.03f));
+
+    Node* nodes[] = {root.get(), childPtr};
+    std::vector<glm::mat4> matrices(2);
+    Node::exportCameraRelativeMatrices(nodes, glm::dvec3(8000000.0, 0.0, 0.05), matrices);
+
+    EXPECT_VEC3_NEAR(glm::vec3(matrices[0][3]), glm::vec3(0.0f, 0.0f, -0.05f));
+    EXPECT_VEC3_NEAR(glm::vec3(matrices[1][3]), glm::vec3(0.0f, 0.0f, 0.01f));
+    EXPECT_VEC3_NEAR(glm::vec3(matrices[1][0]), glm::vec3(2.0f, 0.0f, 0.0f));
+}
+
+// === Layer Mask Tests ===
+
+TEST_F(NodeTests, checkSubtreeLayerMaskFollowsMaskChanges)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto child = std::make_unique<Node>("CHILD");
+    auto grandchild = std::make_unique<Node>("GRANDCHILD");
+    Node* childPtr = child.get();
+    Node* grandchildPtr = grandchild.get();
+    child->addChild(std::move(grandchild));
+    root->addChild(std::move(child));
+
+    grandchildPtr->setLayerMask(0b0100);
+    childPtr->setLayerMask(0b0001);
+    EXPECT_EQ(root->getSubtreeLayerMask(), 0b0101u);
+    EXPECT_EQ(root->getLayerMask(), 0u);
+
+    grandchildPtr->setLayerMask(0);
+    EXPECT_EQ(childPtr->getSubtreeLayerMask(), 0b0001u);
+    EXPECT_EQ(root->getSubtreeLayerMask(), 0b0001u);
+}
+
+TEST_F(NodeTests, checkSubtreeLayerMaskFollowsHierarchyChanges)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto child = std::make_unique<Node>("CHILD");
+    auto grandchild = std::make_unique<Node>("GRANDCHILD");
+    grandchild->setLayerMask(1ull << 63);
+    Node* childPtr = child.get();
+    Node* grandchildPtr = grandchild.get();
+    root->addChild(std::move(child));
+
+    childPtr->addChild(std::move(grandchild));
+    EXPECT_EQ(root->getSubtreeLayerMask(), 1ull << 63);
+
+    std::unique_ptr<Node> detached = childPtr->removeChild(grandchildPtr);
+    EXPECT_EQ(root->getSubtreeLayerMask(), 0u);
+
+    childPtr->addChild(std::move(detached));
+    std::vector<std::unique_ptr<Node>> removed = root->removeAllChildren();
+    EXPECT_EQ(root->getSubtreeLayerMask(), 0u);
+    EXPECT_EQ(removed.front()->getSubtreeLayerMask(), 1ull << 63);
+
+    std::unique_ptr<Node> copy = removed.front()->clone();
+    EXPECT_EQ(copy->getSubtreeLayerMask(), 1ull << 63);
+    EXPECT_EQ(copy->getChildren().front()->getLayerMask(), 1ull << 63);
+}
+
+TEST_F(NodeTests, checkFilteredTraverseVisitsOnlyMatchingNodes)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    for (int i = 0; i < 4; ++i)
+    {
+        auto branch = std::make_unique<Node>("BRANCH" + std::to_string(i));
+        for (int j = 0; j < 4; ++j)
+        {
+            auto leaf = std::make_unique<Node>("LEAF" + std::to_string(i) + std::to_string(j));
+            if (i == 2 && j % 2 == 0)
+            {
+                leaf->setLayerMask(0b10);
+            }
+            branch->addChild(std::move(leaf));
+        }
+        root->addChild(std::move(branch));
+    }
+
+    std::vector<std::string> visited;
+    root->traverse(0b10, [&](const Node& node) {
+        visited.emplace_back(node.getIdentifier());
+    });
+    EXPECT_EQ(visited, (std::vector<std::string>{"LEAF20", "LEAF22"}));
+
+    size_t count = 0;
+    root->traverse(0b01, [&](Node&) { ++count; });
+    EXPECT_EQ(count, 0u);
+}
+
+// === Relative Transform Tests ===
+
+namespace {
+
+void expectMatrixNear(const glm::mat4& actual, const glm::mat4& expected, float eps = 1e-4f)
+{
+    for (int column = 0; column < 4; ++column)
+    {
+        for (int row = 0; row < 4; ++row)
+        {
+            EXPECT_NEAR(actual[column][row], expected[column][row], eps);
+        }
+    }
+}
+
+}
+
+TEST_F(NodeTests, checkFindCommonAncestor)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto arm = std::make_unique<Node>("ARM");
+    auto hand = std::make_unique<Node>("HAND");
+    auto head = std::make_unique<Node>("HEAD");
+    Node* armPtr = arm.get();
+    Node* handPtr = hand.get();
+    Node* headPtr = head.get();
+    arm->addChild(std::move(hand));
+    root->addChild(std::move(arm));
+    root->addChild(std::move(head));
+
+    EXPECT_EQ(handPtr->findCommonAncestor(*headPtr), root.get());
+    EXPECT_EQ(handPtr->findCommonAncestor(*armPtr), armPtr);
+    EXPECT_EQ(handPtr->findCommonAncestor(*handPtr), handPtr);
+
+    Node other("OTHER");
+    EXPECT_EQ(handPtr->findCommonAncestor(other), nullptr);
+}
+
+TEST_F(NodeTests, checkTransformRelativeToMatchesWorldMatrices)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto arm = std::make_unique<Node>("ARM");
+    auto hand = std::make_unique<Node>("HAND");
+    auto weapon = std::make_unique<Node>("WEAPON");
+    auto camera = std::make_unique<Node>("CAMERA");
+    Node* handPtr = hand.get();
+    Node* weaponPtr = weapon.get();
+    Node* cameraPtr = camera.get();
+
+    root->setPosition(glm::vec3(100.0f, 0.0f, -20.0f));
+    root->setRotation(glm::angleAxis(0.4f, glm::vec3(0.0f, 1.0f, 0.0f)));
+    arm->setPosition(glm::vec3(0.5f, 1.5f, 0.0f));
+    arm->setRotation(glm::angleAxis(-0.7f, glm::vec3(0.0f, 0.0f, 1.0f)));
+    arm->setScale(glm::vec3(1.0f, 2.0f, 1.0f));
+    hand->setPosition(glm::vec3(0.0f, 0.6f, 0.0f));
+    weapon->setPosition(glm::vec3(0.1f, 0.0f, 0.3f));
+    weapon->setRotation(glm::angleAxis(1.1f, glm::vec3(1.0f, 0.0f, 0.0f)));
+    camera->setPosition(glm::vec3(0.0f, 1.7f, 3.0f));
+    camera->setRotation(glm::angleAxis(0.2f, glm::vec3(1.0f, 0.0f, 0.0f)));
+    camera->setScale(0.5f);
+
+    hand->addChild(std::move(weapon));
+    arm->addChild(std::move(hand));
+    root->addChild(std::move(arm));
+    root->addChild(std::move(camera));
+
+    const glm::mat4 relative = weaponPtr->getTransformRelativeTo(*cameraPtr);
+    const glm::mat4 expected = glm::inverse(cameraPtr->getGlobalMatrix()) * weaponPtr->getGlobalMatrix();
+    expectMatrixNear(relative, expected);
+
+    // Along a single chain the result is the plain local matrix
+    expectMatrixNear(weaponPtr->getTransformRelativeTo(*handPtr), weaponPtr->getMatrix());
+    expectMatrixNear(weaponPtr->getTransformRelativeTo(*weaponPtr), glm::mat4(1.0f));
+}
+
+TEST_F(NodeTests, checkTransformRelativeToFallsBackForPartialInheritance)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto follower = std::make_unique<Node>("FOLLOWER");
+    auto sibling = std::make_unique<Node>("SIBLING");
+    Node* followerPtr = follower.get();
+    Node* siblingPtr = sibling.get();
+    root->setRotation(glm::angleAxis(0.9f, glm::vec3(0.0f, 1.0f, 0.0f)));
+    root->addChild(std::move(follower));
+    root->addChild(std::move(sibling));
+    followerPtr->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    followerPtr->setInheritance(TransformInheritance::TRANSLATION);
+    siblingPtr->setPosition(glm::vec3(0.0f, 0.0f, 2.0f));
+
+    const glm::mat4 expected = glm::inverse(siblingPtr->getGlobalMatrix()) * followerPtr->getGlobalMatrix();
+    expectMatrixNear(followerPtr->getTransformRelativeTo(*siblingPtr), expected);
+
+    // Different hierarchies compare world matrices
+    Node other("OTHER");
+    other.setPosition(glm::vec3(0.0f, 5.0f, 0.0f));
+    expectMatrixNear(siblingPtr->getTransformRelativeTo(other),
+                     glm::inverse(other.getGlobalMatrix()) * siblingPtr->getGlobalMatrix());
+}
+
+TEST_F(NodeTests, checkTransformRelativeToUsesBakedMatrices)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto frozen = std::make_unique<Node>("FROZEN");
+    auto sibling = std::make_unique<Node>("SIBLING");
+    Node* frozenPtr = frozen.get();
+    Node* siblingPtr = sibling.get();
+    root->addChild(std::move(frozen));
+    root->addChild(std::move(sibling));
+    frozenPtr->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    frozenPtr->freeze();
+
+    // Edited after the bake: the world matrix keeps x=1, and so must the relative one
+    frozenPtr->setPosition(glm::vec3(3.0f, 0.0f, 0.0f));
+    EXPECT_NEAR(frozenPtr->getTransformRelativeTo(*siblingPtr)[3].x, 1.0f, 1e-5f);
+    EXPECT_NEAR(siblingPtr->getTransformRelativeTo(*frozenPtr)[3].x, -1.0f, 1e-5f);
+}
+
+TEST_F(NodeTests, checkCachedTransformRelativeToInvalidates)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto a = std::make_unique<Node>("A");
+    auto b = std::make_unique<Node>("B");
+    Node* aPtr = a.get();
+    Node* bPtr = b.get();
+    root->addChild(std::move(a));
+    root->addChild(std::move(b));
+    aPtr->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+
+    RelativeTransformCache cache;
+    const glm::mat4 first = aPtr->getTransformRelativeTo(*bPtr, cache);
+    EXPECT_NEAR(first[3].x, 1.0f, 1e-5f);
+    const std::uint32_t version = aPtr->getGlobalMatrixVersion();
+
+    // Clean on both sides: served from the cache without recomputation
+    (void)aPtr->getTransformRelativeTo(*bPtr, cache);
+    EXPECT_EQ(aPtr->getGlobalMatrixVersion(), version);
+
+    bPtr->setPosition(glm::vec3(0.0f, 0.0f, 4.0f));
+    const glm::mat4 moved = aPtr->getTransformRelativeTo(*bPtr, cache);
+    EXPECT_NEAR(moved[3].z, -4.0f, 1e-5f);
+
+    // A different pair never reuses the entry
+    const glm::mat4 reversed = bPtr->getTransformRelativeTo(*aPtr, cache);
+    EXPECT_NEAR(reversed[3].x, -1.0f, 1e-5f);
+    EXPECT_NEAR(reversed[3].z, 4.0f, 1e-5f);
+}
+
+// === Reparent Tests ===
+
+TEST_F(NodeTests, checkReparentKeepsWorldPose)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto table = std::make_unique<Node>("TABLE");
+    auto hand = std::make_unique<Node>("HAND");
+    Node* tablePtr = table.get();
+    Node* handPtr = hand.get();
+    table->setPosition(glm::vec3(2.0f, 0.8f, 0.0f));
+    table->setRotation(glm::angleAxis(0.6f, glm::vec3(0.0f, 1.0f, 0.0f)));
+    hand->setPosition(glm::vec3(-1.0f, 1.2f, 0.5f));
+    hand->setRotation(glm::angleAxis(-1.2f, glm::vec3(1.0f, 0.0f, 0.0f)));
+    hand->setScale(0.5f);
+    root->addChild(std::move(table));
+    root->addChild(std::move(hand));
+
+    std::vector<Node*> items;
+    for (int i = 0; i < 3; ++i)
+    {
+        auto item = std::make_unique<Node>("ITEM" + std::to_string(i));
+        item->setPosition(glm::vec3(0.1f * i, 0.0f, 0.2f));
+        item->setRotation(glm::angleAxis(0.3f * i, glm::vec3(0.0f, 0.0f, 1.0f)));
+        items.push_back(item.get());
+        tablePtr->addChild(std::move(item));
+    }
+    std::vector<glm::mat4> before;
+    for (Node* item : items)
+    {
+        before.push_back(item->getGlobalMatrix());
+    }
+
+    Node::reparent(items, handPtr);
+
+    EXPECT_FALSE(tablePtr->hasChildren());
+    ASSERT_EQ(handPtr->getChildren().size(), 3u);
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        EXPECT_EQ(items[i]->getParent(), handPtr);
+        EXPECT_EQ(handPtr->getChildren()[i].get(), items[i]);
+        const glm::mat4& after = items[i]->getGlobalMatrix();
+        for (int column = 0; column < 4; ++column)
+        {
+            EXPECT_VEC3_NEAR(glm::vec3(after[column]), glm::vec3(before[i][column]), 1e-4f);
+        }
+    }
+    EXPECT_VEC3_NEAR(items[0]->getScale(), glm::vec3(2.0f), 1e-4f);
+}
+
+TEST_F(NodeTests, checkReparentKeepLocalAndNestedNodes)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto from = std::make_unique<Node>("FROM");
+    auto to = std::make_unique<Node>("TO");
+    auto outer = std::make_unique<Node>("OUTER");
+    auto inner = std::make_unique<Node>("INNER");
+    auto stay = std::make_unique<Node>("STAY");
+    Node* fromPtr = from.get();
+    Node* toPtr = to.get();
+    Node* outerPtr = outer.get();
+    Node* innerPtr = inner.get();
+    inner->setLayerMask(0b100);
+    to->setPosition(glm::vec3(0.0f, 10.0f, 0.0f));
+    outer->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    inner->setPosition(glm::vec3(0.0f, 0.0f, 1.0f));
+    outer->addChild(std::move(inner));
+    from->addChild(std::move(outer));
+    from->addChild(std::move(stay));
+    root->addChild(std::move(from));
+    root->addChild(std::move(to));
+
+    // Both a node and its descendant move; local transforms are kept as they are
+    Node* nodes[] = {innerPtr, outerPtr};
+    Node::reparent(nodes, toPtr, KeepWorld::NO);
+
+    EXPECT_EQ(fromPtr->getChildren().size(), 1u);
+    EXPECT_FALSE(outerPtr->hasChildren());
+    EXPECT_EQ(innerPtr->getParent(), toPtr);
+    EXPECT_VEC3_NEAR(innerPtr->getPosition(Coordinates::WORLD), glm::vec3(0.0f, 10.0f, 1.0f));
+    EXPECT_VEC3_NEAR(outerPtr->getPosition(Coordinates::WORLD), glm::vec3(1.0f, 10.0f, 0.0f));
+    EXPECT_EQ(fromPtr->getSubtreeLayerMask(), 0u);
+    EXPECT_EQ(toPtr->getSubtreeLayerMask(), 0b100u);
+}
+
+TEST_F(NodeTests, checkReparentMovesDuplicatesOnce)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto from = std::make_unique<Node>("FROM");
+    auto to = std::make_unique<Node>("TO");
+    auto first = std::make_unique<Node>("FIRST");
+    auto second = std::make_unique<Node>("SECOND");
+    Node* fromPtr = from.get();
+    Node* toPtr = to.get();
+    Node* firstPtr = first.get();
+    Node* secondPtr = second.get();
+    to->setPosition(glm::vec3(0.0f, 10.0f, 0.0f));
+    from->addChild(std::move(first));
+    from->addChild(std::move(second));
+    root->addChild(std::move(from));
+    root->addChild(std::move(to));
+
+    Node* nodes[] = {secondPtr, firstPtr, secondPtr};
+    Node::reparent(nodes, toPtr);
+
+    EXPECT_FALSE(fromPtr->hasChildren());
+    ASSERT_EQ(toPtr->getChildren().size(), 2u);
+    EXPECT_EQ(toPtr->getChildren()[0].get(), secondPtr);
+    EXPECT_EQ(toPtr->getChildren()[1].get(), firstPtr);
+    EXPECT_VEC3_NEAR(secondPtr->getPosition(Coordinates::WORLD), glm::vec3(0.0f));
+}
+
+// === Bulk Children Tests ===
+
+TEST_F(NodeTests, checkAddChildrenAppendsInOrder)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    root->addChild(std::make_unique<Node>("FIRST"));
+    root->setPosition(glm::vec3(0.0f, 2.0f, 0.0f));
+
+    std::vector<std::unique_ptr<Node>> spawned;
+    for (int i = 0; i < 4; ++i)
+    {
+        spawned.push_back(std::make_unique<Node>("SPAWNED" + std::to_string(i)));
+    }
+    spawned[3]->setLayerMask(0b1);
+    root->addChildren(std::move(spawned));
+
+    EXPECT_TRUE(spawned.empty());
+    ASSERT_EQ(root->getChildren().size(), 5u);
+    EXPECT_EQ(root->getChildren()[4]->getIdentifier(), "SPAWNED3");
+    EXPECT_EQ(root->getChildren()[4]->getParent(), root.get());
+    EXPECT_EQ(root->getChildren()[2]->getPreviousSibling(), root->getChildren()[1].get());
+    EXPECT_EQ(root->getChildren()[2]->getNextSibling(), root->getChildren()[3].get());
+    EXPECT_VEC3_NEAR(root->getChildren()[4]->getPosition(Coordinates::WORLD), glm::vec3(0.0f, 2.0f, 0.0f));
+    EXPECT_EQ(root->getSubtreeLayerMask(), 0b1u);
+}
+
+TEST_F(NodeTests, checkOrderedRemovalKeepsSiblingIndices)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    std::vector<Node*> children;
+    for (int i = 0; i < 5; ++i)
+    {
+        auto child = std::make_unique<Node>("CHILD" + std::to_string(i));
+        children.push_back(child.get());
+        root->addChild(std::move(child));
+    }
+
+    std::unique_ptr<Node> removed = root->removeChild(children[1]);
+    EXPECT_EQ(removed.get(), children[1]);
+    EXPECT_EQ(root->getChildren()[1].get(), children[2]);
+    EXPECT_EQ(children[4]->getPreviousSibling(), children[3]);
+    EXPECT_EQ(children[2]->getPreviousSibling(), children[0]);
+
+    // Later removals still find the shifted children directly
+    EXPECT_EQ(root->removeChild(children[4]).get(), children[4]);
+    EXPECT_EQ(children[3]->getNextSibling(), nullptr);
+}
+
+TEST_F(NodeTests, checkUnorderedRemovalSwapsLastChild)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    root->setUnorderedChildren(true);
+    std::vector<Node*> children;
+    std::vector<std::unique_ptr<Node>> spawned;
+    for (int i = 0; i < 4; ++i)
+    {
+        spawned.push_back(std::make_unique<Node>("CHILD" + std::to_string(i)));
+        children.push_back(spawned.back().get());
+    }
+    root->addChildren(std::move(spawned));
+
+    std::unique_ptr<Node> removed = root->removeChild(children[0]);
+    EXPECT_EQ(removed.get(), children[0]);
+    EXPECT_FALSE(removed->hasParent());
+    ASSERT_EQ(root->getChildren().size(), 3u);
+    EXPECT_EQ(root->getChildren()[0].get(), children[3]);
+    EXPECT_EQ(children[3]->getNextSibling(), children[1]);
+
+    // Removing the last child needs no swap
+    EXPECT_EQ(root->removeChild(children[2]).get(), children[2]);
+    EXPECT_EQ(root->removeChild(children[3]).get(), children[3]);
+    ASSERT_EQ(root->getChildren().size(), 1u);
+    EXPECT_EQ(root->getChildren()[0].get(), children[1]);
+    EXPECT_EQ(children[1]->getPreviousSibling(), nullptr);
+}
+
+// === Node Handle Tests ===
+
+TEST_F(NodeTests, checkHandleResolvesWhileNodeIsAlive)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto child = std::make_unique<Node>("CHILD");
+    Node* childPtr = child.get();
+    root->addChild(std::move(child));
+
+    const NodeHandle handle = childPtr->getHandle();
+    EXPECT_FALSE(handle.isNull());
+    EXPECT_EQ(childPtr->getHandle(), handle);
+    EXPECT_EQ(Node::resolve(handle), childPtr);
+    EXPECT_EQ(NodeHandle::fromId(childPtr->getId()), handle);
+    EXPECT_NE(root->getHandle(), handle);
+
+    EXPECT_EQ(Node::resolve(NodeHandle{}), nullptr);
+}
+
+TEST_F(NodeTests, checkHandleFailsAfterDestruction)
+{
+    auto first = std::make_unique<Node>("FIRST");
+    const NodeHandle stale = first->getHandle();
+    first.reset();
+    EXPECT_EQ(Node::resolve(stale), nullptr);
+
+    // The slot is reused with a new generation; the old handle stays dead
+    auto second = std::make_unique<Node>("SECOND");
+    const NodeHandle fresh = second->getHandle();
+    EXPECT_EQ(fresh.index, stale.index);
+    EXPECT_NE(fresh.generation, stale.generation);
+    EXPECT_EQ(Node::resolve(stale), nullptr);
+    EXPECT_EQ(Node::resolve(fresh), second.get());
+}
+
+TEST_F(NodeTests, checkBatchResolveAndSubtreeDestruction)
+{
+    std::unique_ptr<Node> root = std::make_unique<Node>("ROOT");
+    auto branch = std::make_unique<Node>("BRANCH");
+    auto leaf = std::make_unique<Node>("LEAF");
+    Node* branchPtr = branch.get();
+    Node* leafPtr = leaf.get();
+    branch->addChild(std::move(leaf));
+    root->addChild(std::move(branch));
+
+    const NodeHandle handles[] = {root->getHandle(), branchPtr->getHandle(), leafPtr->getHandle()};
+    Node* resolved[3] = {};
+    Node::resolve(handles, resolved);
+    EXPECT_EQ(resolved[0], root.get());
+    EXPECT_EQ(resolved[1], branchPtr);
+    EXPECT_EQ(resolved[2], leafPtr);
+
+    // Destroying a subtree invalidates every handle inside it
+    std::unique_ptr<Node> detached = branchPtr->detach();
+    detached.reset();
+    Node::resolve(handles, resolved);
+    EXPECT_EQ(resolved[0], root.get());
+    EXPECT_EQ(resolved[1], nullptr);
+    EXPECT_EQ(resolved[2], nullptr);
+
+    // Clones get handles of their own
+    std::unique_ptr<Node> copy = root->clone();
+    EXPECT_NE(copy->getHandle(), root->getHandle());
+}
@@ -0,0 +1,125 @@
+//
+//  PoseSetTests.cpp
+//  eSGraph
+//
+
+#include "PoseSetTests.hpp"
+#include "PoseSet.hpp"
+#include "Node.hpp"
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace eSGraph;
+
+namespace {
+
+std::unique_ptr<Node> makeRig()
+{
+    auto pelvis = std::make_unique<Node>("PELVIS");
+    auto spine = std::make_unique<Node>("SPINE");
+    auto head = std::make_unique<Node>("HEAD");
+    spine->setPosition(glm::vec3(0.0f, 1.0f, 0.0f));
+    head->setPosition(glm::vec3(0.0f, 0.5f, 0.0f));
+    spine->addChild(std::move(head));
+    pelvis->addChild(std::move(spine));
+    pelvis->addChild(std::make_unique<Node>("TAIL"));
+    return pelvis;
+}
+
+void expectMatrixNear(const glm::mat4& actual, const glm::mat4& expected)
+{
+    for (int column = 0; column < 4; ++column)
+    {
+        for (int row = 0; row < 4; ++row)
+        {
+            EXPECT_NEAR(actual[column][row], expected[column][row], 1e-5f);
+        }
+    }
+}
+
+}
+
+void PoseSetTests::SetUp()
+{
+}
+
+void PoseSetTests::TearDown()
+{
+}
+
+TEST_F(PoseSetTests, checkMatchesNodeHierarchy)
+{
+    auto rig = makeRig();
+    PoseSet poses(std::make_shared<Prototype>(*rig));
+    const size_t spine = poses.getTopology().find("SPINE");
+    const size_t head = poses.getTopology().find("HEAD");
+
+    const size_t first = poses.spawn();
+    const size_t second = poses.spawn();
+    EXPECT_EQ(poses.size(), 2u);
+    EXPECT_EQ(poses.getJointCount(), 4u);
+
+    const glm::quat bend = glm::angleAxis(glm::radians(45.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    poses.setPosition(second, 0, glm::vec3(5.0f, 0.0f, 0.0f));
+    poses.setRotation(second, spine, bend);
+    poses.setScale(second, head, glm::vec3(2.0f));
+
+    // Instances are independent and start in the bind pose
+    expectMatrixNear(poses.getGlobalMatrix(first, head), rig->findByIdentifier("HEAD")->getGlobalMatrix());
+
+    rig->setPosition(glm::vec3(5.0f, 0.0f, 0.0f));
+    rig->findByIdentifier("SPINE")->setRotation(bend);
+    rig->findByIdentifier("HEAD")->setScale(2.0f);
+    expectMatrixNear(poses.getGlobalMatrix(second, head), rig->findByIdentifier("HEAD")->getGlobalMatrix());
+    expectMatrixNear(poses.getGlobalMatrix(second, spine), rig->findByIdentifier("SPINE")->getGlobalMatrix());
+}
+
+TEST_F(PoseSetTests, checkBatchSettersAcrossInstances)
+{
+    auto rig = makeRig();
+    PoseSet poses(std::make_shared<Prototype>(*rig));
+    const size_t spine = poses.getTopology().find("SPINE");
+
+    // Crosses the initial capacity to exercise the joint-major relayout
+    constexpr size_t count = 40;
+    for (size_t i = 0; i < count; ++i)
+    {
+        poses.spawn();
+    }
+
+    std::vector<glm::vec3> offsets(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        offsets[i] = glm::vec3(static_cast<float>(i), 0.0f, 0.0f);
+    }
+    poses.setPositions(0, offsets);
+
+    const auto spineWorld = poses.getGlobalMatrices(spine);
+    ASSERT_EQ(spineWorld.size(), count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        EXPECT_NEAR(spineWorld[i][3][0], static_cast<float>(i), 1e-6f);
+        EXPECT_NEAR(spineWorld[i][3][1], 1.0f, 1e-6f);
+    }
+    EXPECT_EQ(poses.getPositions(spine).size(), count);
+}
+
+TEST_F(PoseSetTests, checkDespawnSwapsLastInstance)
+{
+    auto rig = makeRig();
+    PoseSet poses(std::make_shared<Prototype>(*rig));
+
+    poses.spawn();
+    poses.spawn();
+    const size_t last = poses.spawn();
+    poses.setPosition(last, 0, glm::vec3(0.0f, 0.0f, 7.0f));
+
+    poses.despawn(0);
+    EXPECT_EQ(poses.size(), 2u);
+    EXPECT_NEAR(poses.getPosition(0, 0).z, 7.0f, 1e-6f);
+    EXPECT_NEAR(poses.getGlobalMatrix(0, 0)[3][2], 7.0f, 1e-6f);
+
+    poses.clear();
+    EXPECT_EQ(poses.size(), 0u);
+}
@@ -0,0 +1,159 @@
+//
+//  SceneFormatTests.cpp
+//  eSGraph
+//
+
+#include "SceneFormatTests.hpp"
+#include "SceneFormat.hpp"
+#include "Node.hpp"
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace eSGraph;
+
+namespace {
+
+void EXPECT_VEC3_NEAR(const glm::vec3& a, const glm::vec3& b, float eps = 1e-5f) {
+    EXPECT_NEAR(a.x, b.x, eps);
+    EXPECT_NEAR(a.y, b.y, eps);
+    EXPECT_NEAR(a.z, b.z, eps);
+}
+
+void EXPECT_QUAT_NEAR(const glm::quat& a, const glm::quat& b, float eps = 1e-5f) {
+    float dot = std::abs(glm::dot(a, b));
+    EXPECT_GT(dot, 1.0f - eps);
+}
+
+std::unique_ptr<Node> buildScene()
+{
+    auto root = std::make_unique<Node>("LEVEL");
+    root->setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+
+    for (int i = 0; i < 3; ++i)
+    {
+        auto tree = std::make_unique<Node>("TREE");
+        tree->setPosition(glm::vec3(static_cast<float>(i) * 10.0f, 0.0f, 0.0f));
+        tree->setRotation(glm::vec3(0.0f, 1.0f, 0.0f), glm::radians(15.0f * static_cast<float>(i)));
+        tree->setScale(glm::vec3(1.0f, 2.0f + static_cast<float>(i), 1.0f));
+
+        auto leaves = std::make_unique<Node>("LEAVES");
+        leaves->setPosition(glm::vec3(0.0f, 5.0f, 0.0f));
+        tree->addChild(std::move(leaves));
+        root->addChild(std::move(tree));
+    }
+    root->addChild(std::make_unique<Node>("ROCK"));
+    return root;
+}
+
+}
+
+void SceneFormatTests::SetUp()
+{
+}
+
+void SceneFormatTests::TearDown()
+{
+}
+
+TEST_F(SceneFormatTests, checkRoundTrip)
+{
+    auto scene = buildScene();
+    std::vector<std::byte> bytes = SceneWriter::write(*scene);
+
+    auto view = SceneView::open(bytes);
+    ASSERT_TRUE(view.has_value());
+    ASSERT_EQ(view->size(), 8u);
+    EXPECT_EQ(view->getIdentifier(0), "LEVEL");
+    EXPECT_EQ(view->getIdentifier(1), "TREE");
+    EXPECT_EQ(view->getIdentifier(2), "LEAVES");
+    EXPECT_EQ(view->getIdentifier(7), "ROCK");
+    EXPECT_EQ(view->getParentIndices()[0], SceneHeader::NO_PARENT);
+    EXPECT_EQ(view->getParentIndices()[2], 1u);
+    EXPECT_EQ(view->getParentIndices()[3], 0u);
+    EXPECT_VEC3_NEAR(view->getPositions()[0], glm::vec3(1.0f, 2.0f, 3.0f));
+
+    auto loaded = view->instantiate();
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(loaded->getIdentifier(), "LEVEL");
+    ASSERT_EQ(loaded->getChildren().size(), 4u);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        Node* original = scene->getChildren()[i].get();
+        Node* copy = loaded->getChildren()[i].get();
+        EXPECT_VEC3_NEAR(copy->getPosition(), original->getPosition());
+        EXPECT_QUAT_NEAR(copy->getRotation(), original->getRotation());
+        EXPECT_VEC3_NEAR(copy->getScale(), original->getScale());
+        ASSERT_TRUE(copy->hasChildren());
+        EXPECT_VEC3_NEAR(copy->getChildren().front()->getPosition(Coordinates::WORLD),
+                         original->getChildren().front()->getPosition(Coordinates::WORLD));
+    }
+}
+
+TEST_F(SceneFormatTests, checkIdentifiersInterned)
+{
+    auto scene = buildScene();
+    std::vector<std::byte> bytes = SceneWriter::write(*scene);
+
+    SceneHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(SceneHeader));
+    EXPECT_EQ(header.nodeCount, 8u);
+    EXPECT_EQ(header.identifierCount, 4u);
+    EXPECT_EQ(header.stringBytes, std::strlen("LEVELTREELEAVESROCK"));
+}
+
+TEST_F(SceneFormatTests, checkRejectsMalformedData)
+{
+    auto scene = buildScene();
+    std::vector<std::byte> bytes = SceneWriter::write(*scene);
+
+    EXPECT_FALSE(SceneView::open(std::span<const std::byte>(bytes).first(sizeof(SceneHeader) - 1)).has_value());
+    EXPECT_FALSE(SceneView::open(std::span<const std::byte>(bytes).first(bytes.size() - 1)).has_value());
+
+    std::vector<std::byte> badMagic = bytes;
+    badMagic[0] = std::byte{0};
+    EXPECT_FALSE(SceneView::open(badMagic).has_value());
+
+    std::vector<std::byte> futureVersion = bytes;
+    SceneHeader header;
+    std::memcpy(&header, futureVersion.data(), sizeof(SceneHeader));
+    header.version = SceneHeader::VERSION + 1;
+    std::memcpy(futureVersion.data(), &header, sizeof(SceneHeader));
+    EXPECT_FALSE(SceneView::open(futureVersion).has_value());
+
+    std::vector<std::byte> badParent = bytes;
+    std::memcpy(&header, badParent.data(), sizeof(SceneHeader));
+    const std::uint32_t forwardParent = 5;
+    std::memcpy(badParent.data() + header.parentsOffset + 2 * sizeof(std::uint32_t), &forwardParent, sizeof(forwardParent));
+    EXPECT_FALSE(SceneView::open(badParent).has_value());
+}
+
+TEST_F(SceneFormatTests, checkMappedFile)
+{
+    auto scene = buildScene();
+    const std::string path = (std::filesystem::temp_directory_path() / "eSGraph_scene_test.esgs").string();
+    ASSERT_TRUE(SceneWriter::writeFile(*scene, path));
+
+    {
+        MappedFile file(path);
+        ASSERT_TRUE(file.isOpen());
+
+        MappedFile moved(std::move(file));
+        EXPECT_FALSE(file.isOpen());
+        ASSERT_TRUE(moved.isOpen());
+
+        auto view = SceneView::open(moved.getData());
+        ASSERT_TRUE(view.has_value());
+        EXPECT_EQ(view->size(), 8u);
+        EXPECT_EQ(view->getIdentifier(2), "LEAVES");
+
+        auto loaded = view->instantiate();
+        EXPECT_NE(loaded->findByIdentifier("ROCK"), nullptr);
+    }
+
+    std::filesystem::remove(path);
+    EXPECT_FALSE(MappedFile(path).isOpen());
+}
@@ -0,0 +1,113 @@
+//
+//  SkeletonTests.cpp
+//  eSGraph
+//
+
+#include "SkeletonTests.hpp"
+#include "Skeleton.hpp"
+#include "Node.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace eSGraph;
+
+namespace {
+
+std::unique_ptr<Node> makeLeg()
+{
+    auto hip = std::make_unique<Node>("HIP");
+    auto knee = std::make_unique<Node>("KNEE");
+    auto ankle = std::make_unique<Node>("ANKLE");
+    knee->setPosition(glm::vec3(0.0f, -4.0f, 0.0f));
+    ankle->setPosition(glm::vec3(0.0f, -4.0f, 0.0f));
+    knee->addChild(std::move(ankle));
+    hip->addChild(std::move(knee));
+    hip->addChild(std::make_unique<Node>("TOE_TIP"));
+    return hip;
+}
+
+void expectMatrixNear(const glm::mat4& actual, const glm::mat4& expected)
+{
+    for (int column = 0; column < 4; ++column)
+    {
+        for (int row = 0; row < 4; ++row)
+        {
+            EXPECT_NEAR(actual[column][row], expected[column][row], 1e-5f);
+        }
+    }
+}
+
+}
+
+void SkeletonTests::SetUp()
+{
+}
+
+void SkeletonTests::TearDown()
+{
+}
+
+TEST_F(SkeletonTests, checkBindPoseIsIdentity)
+{
+    auto hip = makeLeg();
+    Skeleton skeleton(*hip);
+
+    ASSERT_EQ(skeleton.getJointCount(), 4u);
+    EXPECT_EQ(skeleton.getJoint(1)->getIdentifier(), "KNEE");
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(skeleton.getPalette().data()) % Skeleton::PALETTE_ALIGNMENT, 0u);
+
+    EXPECT_EQ(skeleton.update(), 4u);
+    for (const glm::mat4& entry : skeleton.getPalette())
+    {
+        expectMatrixNear(entry, glm::mat4(1.0f));
+    }
+}
+
+TEST_F(SkeletonTests, checkOnlyChangedJointsAreRecomputed)
+{
+    auto hip = makeLeg();
+    Skeleton skeleton(*hip);
+    skeleton.update();
+
+    EXPECT_EQ(skeleton.update(), 0u);
+
+    // Moving the knee changes the knee and the ankle but not the hip or its other child
+    Node* knee = hip->findByIdentifier("KNEE");
+    knee->rotate(glm::vec3(0.0f, 0.0f, 1.0f), glm::radians(90.0f));
+    EXPECT_EQ(skeleton.update(), 2u);
+
+    const auto palette = skeleton.getPalette();
+    for (size_t joint = 0; joint < skeleton.getJointCount(); ++joint)
+    {
+        Node* node = skeleton.getJoint(joint);
+        expectMatrixNear(palette[joint], node->getGlobalMatrix() * skeleton.getInverseBindMatrices()[joint]);
+    }
+
+    // The palette maps the ankle's bind position to its new world position
+    const glm::vec4 bindAnkle(0.0f, -8.0f, 0.0f, 1.0f);
+    const glm::vec4 skinned = palette[2] * bindAnkle;
+    EXPECT_NEAR(skinned.x, 4.0f, 1e-4f);
+    EXPECT_NEAR(skinned.y, -4.0f, 1e-4f);
+
+    // Moving the root touches every joint
+    hip->translate(glm::vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(skeleton.update(), 4u);
+}
+
+TEST_F(SkeletonTests, checkExplicitJointList)
+{
+    auto hip = makeLeg();
+    Node* knee = hip->findByIdentifier("KNEE");
+    Node* ankle = hip->findByIdentifier("ANKLE");
+
+    const std::vector<glm::mat4> inverseBind = {
+        glm::inverse(knee->getGlobalMatrix()),
+        glm::inverse(ankle->getGlobalMatrix())};
+    Skeleton skeleton({knee, ankle}, inverseBind);
+
+    hip->setPosition(glm::vec3(0.0f, 10.0f, 0.0f));
+    EXPECT_EQ(skeleton.update(), 2u);
+    EXPECT_NEAR(skeleton.getPalette()[1][3][1], 10.0f, 1e-5f);
+}
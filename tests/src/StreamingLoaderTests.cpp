@@ -0,0 +1,144 @@
+//
+//  StreamingLoaderTests.cpp
+//  eSGraph
+//
+
+#include "StreamingLoaderTests.hpp"
+#include "StreamingLoader.hpp"
+#include "SceneFormat.hpp"
+#include "SpscQueue.hpp"
+#include "Node.hpp"
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <gtest/gtest.h>
+
+using namespace eSGraph;
+
+namespace {
+
+std::vector<std::byte> serializeCell(const std::string& identifier, const glm::vec3& position)
+{
+    auto cell = std::make_unique<Node>(identifier);
+    cell->setPosition(position);
+    cell->addChild(std::make_unique<Node>(identifier + "_PROP"));
+    return SceneWriter::write(*cell);
+}
+
+// Polls update() until the loader has nothing pending or the timeout expires
+size_t attachAll(StreamingLoader& loader, std::chrono::microseconds budget)
+{
+    size_t attached = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (loader.getPendingCount() > 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        attached += loader.update(budget);
+        std::this_thread::yield();
+    }
+    return attached;
+}
+
+}
+
+void StreamingLoaderTests::SetUp()
+{
+}
+
+void StreamingLoaderTests::TearDown()
+{
+}
+
+TEST_F(StreamingLoaderTests, checkSpscQueue)
+{
+    SpscQueue<int> queue(3);
+    EXPECT_EQ(queue.capacity(), 4u);
+    EXPECT_TRUE(queue.empty());
+
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(queue.tryPush(int{i}));
+    }
+    EXPECT_FALSE(queue.tryPush(4));
+
+    int value = -1;
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(queue.tryPush(4));
+
+    for (int expected = 1; expected <= 4; ++expected)
+    {
+        EXPECT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, expected);
+    }
+    EXPECT_FALSE(queue.tryPop(value));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(StreamingLoaderTests, checkAttachesDecodedSubtrees)
+{
+    auto world = std::make_unique<Node>("WORLD");
+    world->setPosition(glm::vec3(0.0f, 100.0f, 0.0f));
+
+    StreamingLoader loader;
+    loader.request(serializeCell("CELL_A", glm::vec3(10.0f, 0.0f, 0.0f)), world.get());
+    loader.request(serializeCell("CELL_B", glm::vec3(20.0f, 0.0f, 0.0f)), world.get());
+    EXPECT_EQ(loader.getPendingCount(), 2u);
+
+    EXPECT_EQ(attachAll(loader, std::chrono::milliseconds(10)), 2u);
+    EXPECT_EQ(loader.getPendingCount(), 0u);
+    EXPECT_EQ(loader.getFailedCount(), 0u);
+
+    Node* prop = world->findByIdentifier("CELL_B_PROP");
+    ASSERT_NE(prop, nullptr);
+    EXPECT_EQ(prop->getParent()->getParent(), world.get());
+    EXPECT_EQ(prop->getPosition(Coordinates::WORLD), glm::vec3(20.0f, 100.0f, 0.0f));
+}
+
+TEST_F(StreamingLoaderTests, checkBudgetLimitsAttachments)
+{
+    auto world = std::make_unique<Node>("WORLD");
+
+    StreamingLoader loader;
+    for (int i = 0; i < 8; ++i)
+    {
+        loader.request(serializeCell("CELL_" + std::to_string(i), glm::vec3(0.0f)), world.get());
+    }
+
+    // A zero budget still attaches one ready subtree per update
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (loader.getPendingCount() > 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        EXPECT_LE(loader.update(std::chrono::microseconds(0)), 1u);
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(world->getChildren().size(), 8u);
+}
+
+TEST_F(StreamingLoaderTests, checkFailedRequests)
+{
+    auto world = std::make_unique<Node>("WORLD");
+
+    StreamingLoader loader;
+    loader.request(std::vector<std::byte>(16, std::byte{0}), world.get());
+    loader.request(std::string("does/not/exist.esgs"), world.get());
+    loader.request(serializeCell("CELL", glm::vec3(0.0f)), world.get());
+
+    attachAll(loader, std::chrono::milliseconds(10));
+
+    EXPECT_EQ(loader.getFailedCount(), 2u);
+    EXPECT_EQ(loader.getPendingCount(), 0u);
+    EXPECT_EQ(world->getChildren().size(), 1u);
+}
+
+TEST_F(StreamingLoaderTests, checkDestroyWithPendingRequests)
+{
+    auto world = std::make_unique<Node>("WORLD");
+    {
+        StreamingLoader loader(1);
+        for (int i = 0; i < 16; ++i)
+        {
+            loader.request(serializeCell("CELL", glm::vec3(0.0f)), world.get());
+        }
+    }
+    EXPECT_FALSE(world->hasChildren());
+}
@@ -0,0 +1,145 @@
+//
+//  TransformCodecTests.cpp
+//  eSGraph
+//
+
+#include "TransformCodecTests.hpp"
+#include "TransformCodec.hpp"
+#include "Node.hpp"
+#include <cmath>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace eSGraph;
+
+void TransformCodecTests::SetUp()
+{
+}
+
+void TransformCodecTests::TearDown()
+{
+}
+
+TEST_F(TransformCodecTests, checkRotationWithinErrorBound)
+{
+    const glm::vec3 axes[] = {
+        glm::normalize(glm::vec3(1.0f, 0.0f, 0.0f)),
+        glm::normalize(glm::vec3(0.3f, -0.8f, 0.5f)),
+        glm::normalize(glm::vec3(-1.0f, 1.0f, 1.0f)),
+    };
+
+    for (const glm::vec3& axis : axes)
+    {
+        for (float degrees = -350.0f; degrees <= 350.0f; degrees += 25.0f)
+        {
+            const glm::quat rotation = glm::angleAxis(glm::radians(degrees), axis);
+            const glm::quat decoded = TransformCodec::unpackRotation(TransformCodec::packRotation(rotation));
+
+            // Compare up to sign; the derived largest component carries a slightly larger error
+            const float sign = glm::dot(rotation, decoded) < 0.0f ? -1.0f : 1.0f;
+            EXPECT_NEAR(decoded.x * sign, rotation.x, 2.0f * TransformCodec::ROTATION_ERROR);
+            EXPECT_NEAR(decoded.y * sign, rotation.y, 2.0f * TransformCodec::ROTATION_ERROR);
+            EXPECT_NEAR(decoded.z * sign, rotation.z, 2.0f * TransformCodec::ROTATION_ERROR);
+            EXPECT_NEAR(decoded.w * sign, rotation.w, 2.0f * TransformCodec::ROTATION_ERROR);
+        }
+    }
+}
+
+TEST_F(TransformCodecTests, checkHalfConversion)
+{
+    EXPECT_EQ(TransformCodec::packHalf(1.0f), 0x3C00);
+    EXPECT_EQ(TransformCodec::packHalf(-2.0f), 0xC000);
+    EXPECT_EQ(TransformCodec::packHalf(0.0f), 0x0000);
+    EXPECT_EQ(TransformCodec::packHalf(1e6f), 0x7C00);
+
+    for (float value : {0.001f, 0.5f, 1.0f, 3.14159f, 250.0f, 60000.0f})
+    {
+        const float decoded = TransformCodec::unpackHalf(TransformCodec::packHalf(value));
+        EXPECT_NEAR(decoded, value, value * TransformCodec::SCALE_RELATIVE_ERROR);
+    }
+}
+
+TEST_F(TransformCodecTests, checkBatchRoundTripWithinBounds)
+{
+    const std::vector<glm::vec3> positions = {
+        {-10.0f, 0.0f, 5.0f}, {10.0f, 2.0f, -5.0f}, {0.123f, 1.0f, 0.0f}};
+    const std::vector<glm::quat> rotations = {
+        glm::quat(1.0f, 0.0f, 0.0f, 0.0f),
+        glm::angleAxis(glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f)),
+        glm::angleAxis(glm::radians(-45.0f), glm::vec3(1.0f, 0.0f, 0.0f))};
+    const std::vector<glm::vec3> scales = {{1.0f, 1.0f, 1.0f}, {2.0f, 3.0f, 4.0f}, {0.5f, 0.5f, 0.5f}};
+
+    TransformCodec codec(TransformCodec::computeBounds(positions));
+    std::vector<PackedTransform> packed(positions.size());
+    std::vector<glm::vec3> nonUniformScales;
+    codec.encode(positions, rotations, scales, packed, nonUniformScales);
+
+    ASSERT_EQ(nonUniformScales.size(), 1u);
+    EXPECT_EQ(packed[1].scale, TransformCodec::NON_UNIFORM_SCALE);
+    EXPECT_NE(packed[0].scale, TransformCodec::NON_UNIFORM_SCALE);
+
+    std::vector<glm::vec3> decodedPositions(positions.size());
+    std::vector<glm::quat> decodedRotations(positions.size());
+    std::vector<glm::vec3> decodedScales(positions.size());
+    ASSERT_TRUE(codec.decode(packed, nonUniformScales, decodedPositions, decodedRotations, decodedScales));
+
+    const glm::vec3 error = codec.getPositionError();
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            EXPECT_LE(std::abs(decodedPositions[i][axis] - positions[i][axis]), error[axis] + 1e-6f);
+            EXPECT_NEAR(decodedScales[i][axis], scales[i][axis], scales[i][axis] * TransformCodec::SCALE_RELATIVE_ERROR);
+        }
+        EXPECT_NEAR(std::abs(glm::dot(decodedRotations[i], rotations[i])), 1.0f, 1e-5f);
+    }
+
+    // Records reference more non-uniform scales than were provided
+    EXPECT_FALSE(codec.decode(packed, {}, decodedPositions, decodedRotations, decodedScales));
+}
+
+TEST_F(TransformCodecTests, checkSubtreeRoundTrip)
+{
+    auto makeTree = []()
+    {
+        auto root = std::make_unique<Node>("ROOT");
+        auto child = std::make_unique<Node>("CHILD");
+        child->addChild(std::make_unique<Node>("GRANDCHILD"));
+        root->addChild(std::move(child));
+        root->addChild(std::make_unique<Node>("SIBLING"));
+        return root;
+    };
+
+    auto source = makeTree();
+    source->findByIdentifier("CHILD")->setPosition(glm::vec3(4.0f, -1.0f, 2.0f));
+    source->findByIdentifier("CHILD")->setRotation(glm::angleAxis(glm::radians(60.0f), glm::vec3(0.0f, 0.0f, 1.0f)));
+    source->findByIdentifier("GRANDCHILD")->setPosition(glm::vec3(0.0f, 3.0f, 0.0f));
+    source->findByIdentifier("SIBLING")->setScale(2.0f);
+
+    const auto encoded = TransformCodec::encodeSubtree(*source);
+    EXPECT_EQ(encoded.transforms.size(), 4u);
+    EXPECT_TRUE(encoded.nonUniformScales.empty());
+
+    // 12 bytes per node against 40 bytes of raw TRS
+    const size_t encodedBytes = encoded.transforms.size() * sizeof(PackedTransform) +
+                                encoded.nonUniformScales.size() * sizeof(glm::vec3);
+    EXPECT_LT(encodedBytes * 3, encoded.transforms.size() * 40);
+
+    auto replica = makeTree();
+    ASSERT_TRUE(TransformCodec::decodeSubtree(encoded, *replica));
+
+    const glm::mat4& expected = source->findByIdentifier("GRANDCHILD")->getGlobalMatrix();
+    const glm::mat4& actual = replica->findByIdentifier("GRANDCHILD")->getGlobalMatrix();
+    for (int column = 0; column < 4; ++column)
+    {
+        for (int row = 0; row < 4; ++row)
+        {
+            // Rotation error is amplified by the 3 unit lever arm of the grandchild
+            EXPECT_NEAR(actual[column][row], expected[column][row], 1e-2f);
+        }
+    }
+
+    auto mismatched = std::make_unique<Node>("ROOT");
+    EXPECT_FALSE(TransformCodec::decodeSubtree(encoded, *mismatched));
+}
@@ -0,0 +1,202 @@
+//
+//  TransformRecorderTests.cpp
+//  eSGraph
+//
+
+#include "TransformRecorderTests.hpp"
+#include "TransformRecorder.hpp"
+#include "Node.hpp"
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace eSGraph;
+
+namespace {
+
+std::unique_ptr<Node> makeHierarchy()
+{
+    auto root = std::make_unique<Node>("ROOT");
+    auto arm = std::make_unique<Node>("ARM");
+    arm->addChild(std::make_unique<Node>("HAND"));
+    root->addChild(std::move(arm));
+    root->addChild(std::make_unique<Node>("LEG"));
+    return root;
+}
+
+}
+
+void TransformRecorderTests::SetUp()
+{
+}
+
+void TransformRecorderTests::TearDown()
+{
+}
+
+TEST_F(TransformRecorderTests, checkOnlyChangedNodesAreRecorded)
+{
+    auto root = makeHierarchy();
+    TransformRecorder recorder;
+    recorder.trackSubtree(*root);
+
+    EXPECT_EQ(recorder.getChangedCount(), 0u);
+
+    Node* hand = root->findByIdentifier("HAND");
+    hand->setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    hand->setPosition(glm::vec3(1.0f, 2.0f, 4.0f));
+
+    EXPECT_EQ(recorder.getChangedCount(), 1u);
+    EXPECT_EQ(recorder.getNode(2), hand);
+
+    std::vector<std::uint8_t> delta;
+    recorder.encodeDelta(delta);
+    EXPECT_EQ(recorder.getChangedCount(), 0u);
+    EXPECT_EQ(recorder.getFrame(), 1u);
+
+    // Frame counter, entry count, id, mask and three fixed-point coordinates
+    EXPECT_EQ(delta.size(), sizeof(std::uint32_t) + 1 + 1 + 1 + 3 * sizeof(std::int32_t));
+}
+
+TEST_F(TransformRecorderTests, checkRoundTripToReplica)
+{
+    auto source = makeHierarchy();
+    auto replica = makeHierarchy();
+
+    TransformRecorder sender(0.001f);
+    TransformRecorder receiver(0.001f);
+    sender.trackSubtree(*source);
+    receiver.trackSubtree(*replica);
+
+    source->findByIdentifier("ARM")->setRotation(glm::angleAxis(glm::radians(30.0f), glm::vec3(0.0f, 0.0f, 1.0f)));
+    source->findByIdentifier("HAND")->setPosition(glm::vec3(0.5f, -2.25f, 10.0f));
+    source->findByIdentifier("LEG")->setScale(2.0f);
+
+    std::vector<std::uint8_t> delta;
+    sender.encodeDelta(delta);
+    ASSERT_TRUE(receiver.applyDelta(delta));
+
+    // Applied changes are not recorded again on the receiving side
+    EXPECT_EQ(receiver.getChangedCount(), 0u);
+
+    const glm::mat4& expected = source->findByIdentifier("HAND")->getGlobalMatrix();
+    const glm::mat4& actual = replica->findByIdentifier("HAND")->getGlobalMatrix();
+    for (int column = 0; column < 4; ++column)
+    {
+        for (int row = 0; row < 4; ++row)
+        {
+            EXPECT_NEAR(actual[column][row], expected[column][row], 1e-3f);
+        }
+    }
+    EXPECT_FLOAT_EQ(replica->findByIdentifier("LEG")->getScale().x, 2.0f);
+}
+
+TEST_F(TransformRecorderTests, checkTruncatedDeltaChangesNothing)
+{
+    auto source = makeHierarchy();
+    auto replica = makeHierarchy();
+
+    TransformRecorder sender;
+    TransformRecorder receiver;
+    sender.trackSubtree(*source);
+    receiver.trackSubtree(*replica);
+
+    source->findByIdentifier("ARM")->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    source->findByIdentifier("HAND")->setPosition(glm::vec3(0.0f, 2.0f, 0.0f));
+
+    std::vector<std::uint8_t> delta;
+    sender.encodeDelta(delta);
+
+    // The first entry is intact, the second is cut short
+    std::vector<std::uint8_t> truncated(delta.begin(), delta.end() - 1);
+    EXPECT_FALSE(receiver.applyDelta(truncated));
+    EXPECT_EQ(replica->findByIdentifier("ARM")->getPosition().x, 0.0f);
+    EXPECT_EQ(replica->findByIdentifier("HAND")->getPosition().y, 0.0f);
+
+    // The arm's baseline is still the origin, so moving it locally is still a change
+    replica->findByIdentifier("ARM")->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    std::vector<std::uint8_t> echo;
+    receiver.encodeDelta(echo);
+    EXPECT_EQ(echo.size(), sizeof(std::uint32_t) + 1 + 1 + 1 + 3 * sizeof(std::int32_t));
+
+    ASSERT_TRUE(receiver.applyDelta(delta));
+    EXPECT_FLOAT_EQ(replica->findByIdentifier("HAND")->getPosition().y, 2.0f);
+}
+
+TEST_F(TransformRecorderTests, checkUnchangedComponentsAreSkipped)
+{
+    auto root = makeHierarchy();
+    TransformRecorder recorder(0.01f);
+    recorder.trackSubtree(*root);
+
+    // Below the quantization step: recorded as touched but not encoded
+    root->setPosition(glm::vec3(0.001f, 0.0f, 0.0f));
+    std::vector<std::uint8_t> delta;
+    recorder.encodeDelta(delta);
+    EXPECT_EQ(delta.size(), sizeof(std::uint32_t) + 1);
+
+    // Scale is quantized the same way, with its own precision
+    root->setScale(1.0001f);
+    delta.clear();
+    recorder.encodeDelta(delta);
+    EXPECT_EQ(delta.size(), sizeof(std::uint32_t) + 1);
+
+    root->setScale(3.0f);
+    delta.clear();
+    recorder.encodeDelta(delta);
+    EXPECT_EQ(delta.size(), sizeof(std::uint32_t) + 1 + 1 + 1 + 3 * sizeof(std::int32_t));
+}
+
+TEST_F(TransformRecorderTests, checkOutOfSequenceDeltasAreRejected)
+{
+    auto source = makeHierarchy();
+    auto replica = makeHierarchy();
+
+    TransformRecorder sender;
+    TransformRecorder receiver;
+    sender.trackSubtree(*source);
+    receiver.trackSubtree(*replica);
+    Node* hand = replica->findByIdentifier("HAND");
+
+    std::vector<std::uint8_t> first;
+    source->findByIdentifier("HAND")->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    sender.encodeDelta(first);
+    std::vector<std::uint8_t> second;
+    source->findByIdentifier("HAND")->setPosition(glm::vec3(2.0f, 0.0f, 0.0f));
+    sender.encodeDelta(second);
+
+    // Skipping ahead is refused without touching the replica
+    EXPECT_FALSE(receiver.applyDelta(second));
+    EXPECT_EQ(hand->getPosition().x, 0.0f);
+    EXPECT_EQ(receiver.getExpectedFrame(), 0u);
+
+    ASSERT_TRUE(receiver.applyDelta(first));
+    EXPECT_EQ(receiver.getExpectedFrame(), 1u);
+
+    // A repeated or stale packet is refused as well
+    EXPECT_FALSE(receiver.applyDelta(first));
+    EXPECT_FLOAT_EQ(hand->getPosition().x, 1.0f);
+
+    ASSERT_TRUE(receiver.applyDelta(second));
+    EXPECT_FLOAT_EQ(hand->getPosition().x, 2.0f);
+}
+
+TEST_F(TransformRecorderTests, checkDestroyedNodesAreIgnored)
+{
+    auto root = makeHierarchy();
+    TransformRecorder recorder;
+    recorder.trackSubtree(*root);
+
+    root->findByIdentifier("LEG")->setPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    auto removed = root->removeChild(root->findByIdentifier("LEG"));
+    removed.reset();
+
+    EXPECT_EQ(recorder.getNode(3), nullptr);
+
+    std::vector<std::uint8_t> delta;
+    recorder.encodeDelta(delta);
+    EXPECT_EQ(delta.size(), sizeof(std::uint32_t) + 1);
+
+    std::vector<std::uint8_t> truncated = {1, 0};
+    EXPECT_FALSE(recorder.applyDelta(truncated));
+}